@@ -2,12 +2,14 @@
 #define FREDDI_APPLICATION_H
 
 #include <iostream>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
 #include "exceptions.hpp"
 #include "options.hpp"
 #include "output.hpp"
+#include "server.hpp"
 #include "unit_transformation.hpp"
 
 namespace po = boost::program_options;
@@ -15,32 +17,30 @@ namespace po = boost::program_options;
 
 template <typename Output, typename Options, typename Evolution>
 bool run_application(int ac, char *av[]) {
+	const auto desc = Options::description();
+	std::vector<po::parsed_options> sources;
 	po::variables_map vm;
-	if (! parseOptions<Options>(vm, ac, av)){
+	if (! parseOptions<Options>(vm, sources, desc, ac, av)){
 		return false;
 	}
+	if (vm.count("serve") > 0) {
+		return run_server<Output, Options, Evolution>(vm, desc, sources);
+	}
 	Options opts(vm);
 	std::shared_ptr<Evolution> freddi{new Evolution(opts)};
 	Output output(freddi, vm);
-	for (int i_t = 0; i_t <= static_cast<int>(freddi->args().calc->time / freddi->args().calc->tau); i_t++) {
-		if (i_t % freddi->args().general->temp_sparsity_output == 0) {
-			output.dump();
-		}
-		try {
-			freddi->step();
-		} catch (const RadiusCollapseException &e) {
-			std::cerr
-				<< "Freddi terminated prematurely"
-				<< ", "
-				<< "i_t = " << i_t
-				<< ", "
-				<< "t = " << sToDay(freddi->t()) << " (days)"
-				<< ", "
-				<< "reason: " << e.what()
-				<< std::endl;
-			return true;
-		}
-	}
+	const auto report = [&freddi](const char* what, const size_t i_t, const char* reason) {
+		std::cerr
+			<< what
+			<< ", "
+			<< "i_t = " << i_t
+			<< ", "
+			<< "t = " << sToDay(freddi->t()) << " (days)"
+			<< ", "
+			<< "reason: " << reason
+			<< std::endl;
+	};
+	run_evolution(*freddi, freddi->args().general->output_times, [&output]() { output.dump(); }, report);
 	return true;
 }
 
@@ -28,18 +28,22 @@ public:
 	unsigned int temp_sparsity_output;
 	bool fulldata;
 	bool stdout;
+	// Time moments to output instead of every temp_sparsity_output-th time step, sorted
+	vecd output_times;
 public:
 	GeneralArguments(const std::string& prefix, const std::string& dir,
 				  unsigned short output_precision,
 				  unsigned int temp_sparsity_output,
 				  bool fulldata,
-				  bool stdout):
+				  bool stdout,
+				  const vecd& output_times={}):
 			prefix(prefix),
 			dir(dir),
 			output_precision(output_precision),
 			temp_sparsity_output(temp_sparsity_output),
 			fulldata(fulldata),
-			stdout(stdout) {}
+			stdout(stdout),
+			output_times(output_times) {}
 };
 
 
@@ -262,6 +266,29 @@ public:
 };
 
 
+// Additional observer of the system, its fluxes are calculated from the same disk and star as ones of the main
+// observer of FluxArguments
+class Observer {
+public:
+	double inclination;  // degrees
+	double distance;
+public:
+	Observer(double inclination, double distance):
+			inclination(inclination), distance(distance) {}
+};
+
+
+// Additional X-ray energy band [emin, emax], Hz
+class EnergyBand {
+public:
+	double emin;
+	double emax;
+public:
+	EnergyBand(double emin, double emax):
+			emin(emin), emax(emax) {}
+};
+
+
 class FluxArguments {
 public:
 	constexpr static const double default_colourfactor = 1.7;
@@ -282,6 +309,8 @@ public:
 	bool star;
 	vecd lambdas;
 	std::vector<Passband> passbands;
+	std::vector<Observer> observers;
+	std::vector<EnergyBand> xbands;
 public:
 	FluxArguments(
 			double colourfactor,
@@ -290,14 +319,18 @@ public:
 			double inclination, double ephemeris_t0, double distance,
 	        bool cold_disk, bool star,
 	        const vecd& lambdas,
-	        const std::vector<Passband>& passbands):
+	        const std::vector<Passband>& passbands,
+	        const std::vector<Observer>& observers = {},
+	        const std::vector<EnergyBand>& xbands = {}):
 			colourfactor(colourfactor),
 			emin(emin), emax(emax),
 			star_albedo(star_albedo),
 			inclination(inclination), ephemeris_t0(ephemeris_t0), distance(distance),
 			cold_disk(cold_disk), star(star),
 			lambdas(lambdas),
-			passbands(passbands) {}
+			passbands(passbands),
+			observers(observers),
+			xbands(xbands) {}
 };
 
 
@@ -308,6 +341,19 @@ public:
 	constexpr static const unsigned int default_Nt_for_tau = 200;
 	constexpr static const char default_gridscale[] = "log";
 	constexpr static const unsigned short default_starlod = 3;
+	constexpr static const double default_eps = 1e-6;
+	constexpr static const bool default_front_tracking = false;
+	constexpr static const double default_regrid_tolerance = 0.;
+	constexpr static const char default_time_scheme[] = "euler";
+	constexpr static const char default_space_scheme[] = "central";
+	constexpr static const double default_Mdot_quiescent = 0.;
+	constexpr static const unsigned int default_quiescent_step_factor = 10;
+	constexpr static const double default_self_similar_tolerance = 0.;
+	constexpr static const double default_stop_Mdot = 0.;
+	constexpr static const double default_stop_Lx = 0.;
+	constexpr static const double default_stop_Rhot_to_Rout = 0.;
+	constexpr static const unsigned int default_stop_outbursts = 0;
+	constexpr static const double default_stop_wall_time = 0.;
 public:
 	double init_time;
 	double time;
@@ -316,17 +362,56 @@ public:
 	std::string gridscale;
 	unsigned short starlod = 3;
 	double eps;
+	// Track the position of the hot disk outer boundary between grid points
+	bool front_tracking;
+	// Redistribute grid nodes when the hot disk loses this fraction of its nodes, zero means fixed grid
+	double regrid_tolerance;
+	// Time integration of the diffusion equation: euler (first order) or trbdf2 (second order)
+	std::string time_scheme;
+	// Spatial discretisation of the diffusion equation: central (second order) or compact (fourth order)
+	std::string space_scheme;
+	// Accretion rate below which the evolution is calculated with the larger time step tau_quiescent, zero means never
+	double Mdot_quiescent;
+	// Time step in quiescence, a multiple of tau
+	double tau_quiescent;
+	// Switch to the self-similar decay when a numerical step scales F uniformly within this tolerance, zero means never
+	double self_similar_tolerance;
+	// The calculation stops when one of these conditions is met, zero values disable them. Mdot_in and Lx thresholds
+	// are checked while the accretion rate decays, an outburst is counted when the accretion rate passes its maximum
+	double stop_Mdot;
+	double stop_Lx;
+	double stop_Rhot_to_Rout;
+	unsigned int stop_outbursts;
+	// Wall-clock time in seconds since the evolution was created
+	double stop_wall_time;
 public:
 	CalculationArguments(
 			double inittime,
 			double time, std::optional<double> tau,
 			unsigned int Nx, const std::string& gridscale, const unsigned short starlod,
-			double eps=1e-6):
+			double eps=default_eps, bool front_tracking=default_front_tracking,
+			double regrid_tolerance=default_regrid_tolerance,
+			const std::string& time_scheme=default_time_scheme,
+			const std::string& space_scheme=default_space_scheme,
+			double Mdot_quiescent=default_Mdot_quiescent, std::optional<double> tau_quiescent={},
+			double self_similar_tolerance=default_self_similar_tolerance,
+			double stop_Mdot=default_stop_Mdot, double stop_Lx=default_stop_Lx,
+			double stop_Rhot_to_Rout=default_stop_Rhot_to_Rout, unsigned int stop_outbursts=default_stop_outbursts,
+			double stop_wall_time=default_stop_wall_time):
 			init_time(inittime),
 			time(time),
 			tau(tau ? *tau : time / default_Nt_for_tau),
 			Nx(Nx), gridscale(gridscale), starlod(starlod),
-			eps(eps) {}
+			eps(eps), front_tracking(front_tracking),
+			regrid_tolerance(regrid_tolerance),
+			time_scheme(time_scheme),
+			space_scheme(space_scheme),
+			Mdot_quiescent(Mdot_quiescent),
+			tau_quiescent(tau_quiescent ? *tau_quiescent : default_quiescent_step_factor * this->tau),
+			self_similar_tolerance(self_similar_tolerance),
+			stop_Mdot(stop_Mdot), stop_Lx(stop_Lx),
+			stop_Rhot_to_Rout(stop_Rhot_to_Rout), stop_outbursts(stop_outbursts),
+			stop_wall_time(stop_wall_time) {}
 };
 
 
@@ -0,0 +1,63 @@
+#ifndef FREDDI_C_API_H
+#define FREDDI_C_API_H
+
+/*
+ * C interface of libfreddi to run the model in-process from other languages.
+ *
+ * Models are created from the same options as freddi and freddi-ns command line tools accept, e.g. "--Mx=5" or
+ * "--distance", "10", configuration files are not read. Times are in seconds. Scalars are named and measured as
+ * columns of the PREFIX.dat output file, e.g. "Mdot" or "Lx", and radial fields as columns of PREFIX_%d.dat files,
+ * e.g. "R" or "Sigma". Functions returning int return a negative value on error, the error message of the last failed
+ * call made by the current thread is returned by freddi_last_error()
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct freddi_model freddi_model;
+
+/* Creates a model of freddi (neutron_star = 0) or of freddi-ns (neutron_star != 0), returns NULL on error */
+freddi_model* freddi_create(int argc, const char* const* argv, int neutron_star);
+void freddi_destroy(freddi_model* model);
+const char* freddi_last_error(void);
+
+/* Makes one time step, returns 1 if the step is made and 0 if the calculation is over: the time is out or a stop
+ * condition is met */
+int freddi_step(freddi_model* model);
+/* Steps to the time moment t shortening the last step, returns 1 if t is reached and 0 if the calculation is over */
+int freddi_evolve_to(freddi_model* model, double t);
+
+double freddi_time(const freddi_model* model);
+size_t freddi_i_t(const freddi_model* model);
+size_t freddi_Nx(const freddi_model* model);
+size_t freddi_first(const freddi_model* model);
+size_t freddi_last(const freddi_model* model);
+
+/* Names of the scalars available for the model, index is in [0, freddi_scalar_count()) */
+size_t freddi_scalar_count(const freddi_model* model);
+const char* freddi_scalar_name(const freddi_model* model, size_t index);
+/* Writes values of n scalars with the given names into values */
+int freddi_scalars(freddi_model* model, size_t n, const char* const* names, double* values);
+/* Writes freddi_Nx() values of the radial field into buffer of the given size */
+int freddi_field(freddi_model* model, const char* name, double* buffer, size_t size);
+
+/*
+ * Runs n_models models of the same kind, the model i is created from argcs[i] and argvs[i]. Every model is evolved to
+ * the n_times time moments, and the n_names scalars are written into
+ * values[(i * n_times + j) * n_names + k] for the time moment j and the scalar k. The values of the time moments
+ * which are not reached are NaN. status[i] is zero if the model i has run successfully and negative otherwise.
+ * Models are distributed over n_threads threads dynamically, zero n_threads means the number of CPU cores.
+ * Returns the number of failed models
+ */
+int freddi_run_batch(int neutron_star, size_t n_models, const int* argcs, const char* const* const* argvs,
+		size_t n_times, const double* times, size_t n_names, const char* const* names,
+		double* values, int* status, unsigned int n_threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREDDI_C_API_H */
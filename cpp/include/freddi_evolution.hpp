@@ -1,6 +1,7 @@
 #ifndef FREDDI_FREDDI_EVOLUTION_HPP
 #define FREDDI_FREDDI_EVOLUTION_HPP
 
+#include <chrono>
 #include <functional>  // bind, function
 #include <iterator>
 #include <vector>
@@ -8,6 +9,7 @@
 #include <boost/optional.hpp>
 
 #include "arguments.hpp"
+#include "exceptions.hpp"
 #include "freddi_state.hpp"
 #include "spectrum.hpp"
 
@@ -21,7 +23,18 @@ public:
 	EvolutionIterator(T* evolution): evolution(evolution), i_t(evolution->i_t()) {}
 	EvolutionIterator(size_t i_t): evolution(nullptr), i_t(i_t) {}
 	EvolutionIterator& operator++() {
-		i_t++;
+		// *it++ increments before the old position is dereferenced, so the state of the current position is calculated
+		// here to check its stop condition
+		if (evolution != nullptr) {
+			**this;
+		}
+		// the iteration ends at the state which meets a stop condition
+		if (evolution != nullptr && evolution->stop_reason() != nullptr) {
+			i_t = evolution->Nt() + 1;
+			return *this;
+		}
+		// quiescent steps of the evolution skip several time moments
+		i_t = (evolution != nullptr && evolution->i_t() >= i_t) ? evolution->i_t() + 1 : i_t + 1;
 		return *this;
 	}
 	EvolutionIterator operator++(int) {
@@ -42,15 +55,82 @@ public:
 
 class FreddiEvolution: public FreddiState {
 protected:
-	virtual void truncateOuterRadius();
+	// Returns the outermost index ii in (first(), last()] where is_cold(ii) is false, is_cold(i) should be true
+	// for all i > ii. The front usually moves by a few cells per step, so the search goes inward with doubling
+	// steps from last() and then bisects the bracket, the condition is assumed to be monotone inside it
+	template <typename Cond> size_t search_hot_edge(const Cond& is_cold) const {
+		size_t outer = last() + 1;
+		size_t inner;
+		for (size_t step = 1; ; step *= 2) {
+			if (outer <= first() + 1) {
+				throw RadiusCollapseException();
+			}
+			inner = outer > first() + step ? outer - step : first() + 1;
+			if (!is_cold(inner)) {
+				break;
+			}
+			outer = inner;
+		}
+		while (outer - inner > 1) {
+			const size_t middle = inner + (outer - inner) / 2;
+			if (is_cold(middle)) {
+				outer = middle;
+			} else {
+				inner = middle;
+			}
+		}
+		return inner;
+	}
+	// tau is the length of the current time step, it limits the cooling-front travel
+	virtual void truncateOuterRadius(double tau);
+	// coldness(i) is positive where the disk at h()[i] should be cold and changes linearly between grid points
+	template <typename Coldness> void truncateOuterRadius(const Coldness& coldness);
 	virtual void truncateInnerRadius() {}
+	// Redistributes grid nodes when the hot disk has lost CalculationArguments::regrid_tolerance of its nodes
+	virtual void refineGrid();
+	// Number of time steps tau which the next step() covers: one, or tau_quiescent / tau while Mdot_in() is below
+	// CalculationArguments::Mdot_quiescent and doesn't grow, and the hot disk boundary moves slowly
+	size_t quiescent_step_factor();
+	// The evolution equation has a separable solution F(h, t) = f(h) T(t): the hot disk radius and the inner torque
+	// are fixed, and there is neither wind nor accretion through the outer radius
+	virtual bool self_similar_decay_possible() const;
+	// Switches to the self-similar decay if the last numerical step has scaled F_old uniformly,
+	// see CalculationArguments::self_similar_tolerance
+	void check_self_similarity(const vecd& F_old, double tau);
+	// Counts maxima of Mdot_in() for CalculationArguments::stop_outbursts
+	void count_outbursts();
+private:
+	// Grid of the hot disk with the boundary node moved to h_hot(), see has_front_node()
+	vecd front_h_;
+	// Rate of change of h_hot() during the last step
+	double h_hot_velocity_ = 0.;
+	// F() before the numerical step, used to detect the self-similar decay
+	vecd F_old_;
+	// Time t_s since the singularity of the self-similar decay F ∝ (t_s)^(-1/m), zero while the solution is numerical
+	double self_similar_time_ = 0.;
+	// Number of maxima of Mdot_in() passed
+	unsigned int outbursts_ = 0;
+	bool Mdot_in_rises_ = false;
+	std::chrono::steady_clock::time_point start_time_;
+	// Solver of the diffusion equation for CalculationArguments::time_scheme and space_scheme, resolved once
+	typedef void (*solver_t)(double, double, double, double, const vecd&, const vecd&, const vecd&,
+			const OpacityWProvider&, const vecd&, vecd&, size_t, size_t);
+	solver_t solver_;
+	static solver_t initialize_solver(const CalculationArguments& calc, bool compact);
 protected:
-	virtual vecd wunction(const vecd& h, const vecd& F, size_t first, size_t last) const;
+	// Used for W(), step() passes the same w_provider() to the solver directly
+	vecd wunction(const vecd& h, const vecd& F, size_t first, size_t last) const override;
 public:
 	FreddiEvolution(const FreddiArguments& args);
 	explicit FreddiEvolution(const FreddiEvolution&) = default;
 	virtual void step(double tau);
-	inline void step() { return step(args().calc->tau); }
+	inline void step() { return step(quiescent_step_factor() * args().calc->tau); }
+	// Steps to the time moment t, the last step is shortened to land on it. Returns false without reaching t if t is
+	// later than the end of the calculation or a stop condition is met, see stop_reason()
+	bool evolve_to(double t);
+	// Condition of CalculationArguments which stops the calculation at the current state, nullptr if there is none
+	const char* stop_reason();
+	inline unsigned int outbursts() const { return outbursts_; }
 public:
 	using iterator = EvolutionIterator<FreddiEvolution>;
 	inline iterator begin() { return {this}; }
@@ -58,4 +138,49 @@ public:
 };
 
 
+// Runs the calculation calling dump() for every state to output: at output_times if they are given, or at every
+// GeneralArguments::temp_sparsity_output-th time step otherwise. report(what, i_t, reason) is called when the
+// calculation ends before its time is out
+template <typename Evolution, typename Dump, typename Report>
+void run_evolution(Evolution& freddi, const vecd& output_times, Dump&& dump, Report&& report) {
+	if (!output_times.empty()) {
+		for (const double t : output_times) {
+			try {
+				if (!freddi.evolve_to(t)) {
+					break;
+				}
+			} catch (const RadiusCollapseException &e) {
+				report("Freddi terminated prematurely", freddi.i_t(), e.what());
+				return;
+			}
+			dump();
+		}
+		if (freddi.stop_reason() != nullptr) {
+			report("Freddi stopped", freddi.i_t(), freddi.stop_reason());
+		}
+		return;
+	}
+	const size_t last_i_t = static_cast<size_t>(freddi.args().calc->time / freddi.args().calc->tau);
+	const size_t sparsity = freddi.args().general->temp_sparsity_output;
+	// a quiescent step can jump over several time steps, so dump the first state at or after every multiple of sparsity
+	for (size_t i_t = freddi.i_t(), next_dump = 0; i_t <= last_i_t; i_t = freddi.i_t()) {
+		const char* stop_reason = freddi.stop_reason();
+		if (i_t >= next_dump || stop_reason != nullptr) {
+			dump();
+			next_dump = (i_t / sparsity + 1) * sparsity;
+		}
+		if (stop_reason != nullptr) {
+			report("Freddi stopped", i_t, stop_reason);
+			return;
+		}
+		try {
+			freddi.step();
+		} catch (const RadiusCollapseException &e) {
+			report("Freddi terminated prematurely", i_t, e.what());
+			return;
+		}
+	}
+}
+
+
 #endif //FREDDI_FREDDI_EVOLUTION_HPP
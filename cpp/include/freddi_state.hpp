@@ -185,6 +185,18 @@ private:
 		virtual PeriodPaperWind* clone() const override { return new PeriodPaperWind(*this); }
 		virtual void update(const FreddiState&) override;
 	};
+
+public:
+	// Geometry of an additional observer of FluxArguments::observers
+	class ObserverGeometry {
+	public:
+		double inclination;  // radians
+		double cosi;
+		double distance;
+		double cosiOverD2;
+	public:
+		explicit ObserverGeometry(const Observer& observer);
+	};
 	
 protected:
 	class BasicFreddiIrradiationSource {
@@ -197,14 +209,14 @@ protected:
 		double Height2R(FreddiState& state) const;
 	};
 
-	class IsotropicFreddiIrradiationSource: public BasicFreddiIrradiationSource {
+	class IsotropicFreddiIrradiationSource final: public BasicFreddiIrradiationSource {
 	public:
 		~IsotropicFreddiIrradiationSource() override = default;
 		double angular_dist(double mu) const override;
 		std::unique_ptr<IrrSource> irr_source(FreddiState& state, double luminosity) const override;
 	};
 
-	class PlaneFreddiIrradiationSource: public BasicFreddiIrradiationSource {
+	class PlaneFreddiIrradiationSource final: public BasicFreddiIrradiationSource {
 	protected:
 		const UnitVec3 normal;
 	public:
@@ -214,6 +226,18 @@ protected:
 		std::unique_ptr<IrrSource> irr_source(FreddiState& state, double luminosity) const override;
 	};
 
+	// Calls func with the irradiation source casted to its final type, so angular_dist() calls inside func need
+	// no virtual dispatch. Unknown source types are passed as is
+	template <typename Func> static void visit_irradiation_source(const BasicFreddiIrradiationSource& source, Func&& func) {
+		if (const auto isotropic = dynamic_cast<const IsotropicFreddiIrradiationSource*>(&source)) {
+			func(*isotropic);
+		} else if (const auto plane = dynamic_cast<const PlaneFreddiIrradiationSource*>(&source)) {
+			func(*plane);
+		} else {
+			func(source);
+		}
+	}
+
 private:
 	class DiskStructure {
 	public:
@@ -228,15 +252,69 @@ private:
 		double cosi;
 		double distance;
 		double cosiOverD2;
+		std::vector<ObserverGeometry> observers;
+		// The main band [emin, emax] followed by the bands of FluxArguments::xbands
+		Spectrum::FrequencyBands xbands;
 		OpacityRelated oprel;
 		vecd h;
 		vecd R;
+		// Viscous flux Qvis = sigma T^4 of the relativistic disk divided by Mdot, see Spectrum::T_GR
+		vecd Qvis_GR_over_Mdot;
+		// Viscous flux due to torque F_in at the inner radius, divided by F_in
+		vecd Qvis_over_F_in;
+		// F- and W-independent radial factors of lazy fields:
+		// Tph_vis = Tph_vis_factor * F^(1/4)
+		vecd Tph_vis_factor;
+		// Sigma = Sigma_factor * W
+		vecd Sigma_factor;
+		// Height = Height_factor * F^oprel.Height_exp_F
+		vecd Height_factor;
+		// 1 / (0.05 R), Kirr is a power of Height * Kirr_factor
+		vecd Kirr_factor;
+		// 1 / (4 pi R^2), Qx = Kirr * Lbol * angular distribution * Qx_factor
+		vecd Qx_factor;
+		// W = W_factor * |F|^(1 - oprel.m)
+		vecd W_factor;
+		// Critical surface densities of the cold and hot disk, see FreddiState::Sigma_minus and FreddiState::Sigma_plus
+		vecd Sigma_minus;
+		vecd Sigma_plus;
+		// Sigma-independent parts of the cooling-front velocity, see FreddiState::v_cooling_front
+		vecd log_Sigma_plus;
+		vecd log_Sigma_minus_over_plus;
+		vecd v_cooling_front_factor;
+		// v_cooling_front = v_cooling_front_factor * polynomial(sigma) * exp(v_cooling_front_sigma_exp * sigma)
+		double v_cooling_front_sigma_exp;
+		// CalculationArguments::space_scheme is compact, resolved once instead of comparing strings every step
+		bool compact_space_scheme;
 		wunc_t wunc;
 	private:
 		static vecd initialize_h(const FreddiArguments& args, size_t Nx);
 		static vecd initialize_R(const vecd& h, double GM);
+		static std::vector<ObserverGeometry> initialize_observers(const FluxArguments& flux);
+		static Spectrum::FrequencyBands initialize_xbands(const FluxArguments& flux);
+		static vecd initialize_Qvis_GR_over_Mdot(const FreddiArguments& args, const vecd& R);
+		static vecd initialize_Qvis_over_F_in(const vecd& h, double GM);
+		static vecd initialize_Tph_vis_factor(const vecd& h, double GM);
+		static vecd initialize_Sigma_factor(const vecd& h, double GM);
+		static vecd initialize_Height_factor(const vecd& R, const OpacityRelated& oprel);
+		static vecd initialize_Kirr_factor(const vecd& R);
+		static vecd initialize_Qx_factor(const vecd& R);
+		static vecd initialize_W_factor(const vecd& h, const OpacityRelated& oprel);
+		static vecd initialize_Sigma_minus(const BasicDiskBinaryArguments& basic, const vecd& R);
+		static vecd initialize_Sigma_plus(const BasicDiskBinaryArguments& basic, const vecd& R);
+		static vecd initialize_log(const vecd& x);
+		static vecd initialize_log_ratio(const vecd& numerator, const vecd& denominator);
+		static vecd initialize_v_cooling_front_factor(const BasicDiskBinaryArguments& basic, const vecd& R);
+		static double initialize_v_cooling_front_sigma_exp(const BasicDiskBinaryArguments& basic);
+		static bool initialize_compact_space_scheme(const CalculationArguments& calc);
+	public:
+		static double Sigma_minus_at(const BasicDiskBinaryArguments& basic, double r);
+		static double Sigma_plus_at(const BasicDiskBinaryArguments& basic, double r);
+		static double v_cooling_front_factor_at(const BasicDiskBinaryArguments& basic, double r);
+		static double v_cooling_front_sigma_polynomial(double sigma);
 	public:
 		DiskStructure(const FreddiArguments& args, const wunc_t& wunc);
+		DiskStructure(const FreddiArguments& args, const wunc_t& wunc, vecd&& grid);
 	};
 
 	class CurrentState {
@@ -247,6 +325,9 @@ private:
 		size_t i_t;
 		size_t first;
 		size_t last;
+		// Outer boundary of the hot disk, h[last] <= h_hot < h[last + 2]. It differs from h[last] for
+		// CalculationArguments::front_tracking only, then F[last + 1] is the value at h_hot
+		double h_hot;
 		vecd F;
 		double F_in;
 		explicit CurrentState(const DiskStructure& str);
@@ -257,11 +338,40 @@ private:
 		static vecd initializeF(const DiskStructure& str);
 	};
 
+	// Lazy array which keeps its memory when it is invalidated, so it is not reallocated every step
+	class LazyArray {
+	private:
+		vecd data_;
+		bool valid_ = false;
+	public:
+		inline explicit operator bool() const { return valid_; }
+		inline const vecd& operator*() const { return data_; }
+		inline vecd& operator*() { return data_; }
+		inline const vecd* operator->() const { return &data_; }
+		inline vecd* operator->() { return &data_; }
+		inline LazyArray& operator=(vecd&& x) { data_ = std::move(x); valid_ = true; return *this; }
+		// Marks the array as valid and returns its buffer resized to n and filled with zeros
+		inline vecd& emplace(size_t n) { data_.assign(n, 0.0); valid_ = true; return data_; }
+		inline void reset() { valid_ = false; }
+	};
+
+	// Lazy fields and what they depend on:
+	//   W, Sigma, Tph_vis, Tph_X -- F on [first, last], zero outside of it;
+	//   Height, Kirr, Qx, Tirr, Tph -- F on [first, last], Mdot_in via Lbol, cold disk values outside of [first, last];
+	//   Lx, Lx_bands, Mdisk, Mdot_wind, Inu, Inu_cold, Fnu_star -- integrals over hot
+	//     or cold disk, they depend on first and last.
+	// Change of F invalidates everything, see invalidate_optional_structure(). When only last decreases the arrays
+	// are updated in place for cells that became cold, see truncate_optional_structure()
 	struct DiskOptionalStructure {
 		boost::optional<double> Mdisk;
 		boost::optional<double> Lx;
 		boost::optional<double> Mdot_wind;
-		boost::optional<vecd> W, Tph, Qx, Tph_vis, Tph_X, Tirr, Kirr, Sigma, Height;
+		LazyArray W, Tph, Qx, Tph_vis, Tph_X, Tirr, Kirr, Sigma, Height;
+		LazyArray Lx_bands;
+		LazyArray Inu, Inu_cold;
+		// Indexed as [observer][phase][band], the main observer is followed by observers()
+		boost::optional<std::vector<std::vector<vecd>>> Fnu_star;
+		void invalidate();
 	};
 
 protected:
@@ -270,8 +380,9 @@ protected:
 	DiskOptionalStructure opt_str_;
 	std::unique_ptr<BasicWind> wind_;
 	std::shared_ptr<BasicFreddiIrradiationSource> disk_irr_source_;
-	RocheLobe star_roche_lobe_;
-	IrradiatedStar star_;
+	// Star mesh is built on the first request, its irradiation sources are renewed on request after each step
+	boost::optional<IrradiatedStar> star_;
+	bool star_sources_outdated_ = false;
 public:
 	FreddiState(const FreddiArguments& args, const wunc_t& wunc);
 	explicit FreddiState(const FreddiState&);
@@ -281,6 +392,10 @@ public:
 	virtual void step(double tau);
 private:
 	void initializeWind();
+protected:
+	// Used for W(). It is virtual rather than wunc() bound to a derived object, so a copy of the state calculates W with
+	// its own grid instead of calling the object it was copied from
+	virtual vecd wunction(const vecd& h, const vecd& F, size_t first, size_t last) const { return wunc()(h, F, first, last); }
 // str_
 public:
 	inline size_t Nt() const { return str_->Nt; }
@@ -293,13 +408,37 @@ public:
 	inline double cosi() const { return str_->cosi; }
 	inline double distance() const { return str_->distance; }
 	inline double cosiOverD2() const { return str_->cosiOverD2; }
+	inline const std::vector<ObserverGeometry>& observers() const { return str_->observers; }
+	inline const Spectrum::FrequencyBands& xbands() const { return str_->xbands; }
 	inline const OpacityRelated& oprel() const { return str_->oprel; }
+	inline bool compact_space_scheme() const { return str_->compact_space_scheme; }
 	inline const wunc_t& wunc() const { return str_->wunc; }
+	// W(F) for the opacity law, per-cell W-provider for nonlinear_diffusion_nonuniform_wind_1_2
+	class OpacityWProvider {
+	private:
+		const vecd& W_factor_;
+		const double exp_F_;
+		// W_factor at h_hot() for the boundary node, see has_front_node()
+		const size_t i_front_;
+		const double W_factor_front_;
+	public:
+		OpacityWProvider(const vecd& W_factor, double exp_F, size_t i_front, double W_factor_front):
+				W_factor_(W_factor), exp_F_(exp_F), i_front_(i_front), W_factor_front_(W_factor_front) {}
+		inline double w(size_t i, double F) const {
+			return (i == i_front_ ? W_factor_front_ : W_factor_[i]) * std::pow(std::abs(F), exp_F_);
+		}
+	};
+	inline OpacityWProvider w_provider() const {
+		if (has_front_node()) {
+			return {str_->W_factor, 1. - oprel().m, last() + 1, std::pow(h_hot(), oprel().n) / (1. - oprel().m) / oprel().D};
+		}
+		return {str_->W_factor, 1. - oprel().m, Nx(), 0.};
+	}
 	inline const FreddiArguments& args() const { return str_->args; }
 	inline const vecd& h() const { return str_->h; }
 	inline const vecd& R() const { return str_->R; }
 	inline const vecd& lambdas() const { return str_->args.flux->lambdas; }
-	inline Star& star() { return star_; }
+	Star& star();
 	void replaceArgs(const FreddiArguments& args);  // Danger!
 // current_
 public:
@@ -310,14 +449,21 @@ public:
 	inline size_t i_t() const { return current_.i_t; };
 	inline size_t first() const { return current_.first; }
 	inline size_t last() const { return current_.last; }
+	inline double h_hot() const { return current_.h_hot; }
+	inline double R_hot() const { return m::pow<2>(h_hot()) / GM(); }
+	// Hot disk has an additional boundary node last() + 1 placed at h_hot()
+	inline bool has_front_node() const { return h_hot() > h()[last()]; }
 	inline double Mdot_in_prev() const { return current_.Mdot_in_prev; }
 protected:
 	inline void set_Mdot_in_prev(double Mdot_in) { current_.Mdot_in_prev = Mdot_in; }
 	inline void set_Mdot_in_prev() { set_Mdot_in_prev(Mdot_in()); }
 	virtual IrradiatedStar::sources_t star_irr_sources();
+	inline void invalidate_star_sources() { star_sources_outdated_ = true; }
 public:
 	inline double omega_R(double r) const { return std::sqrt(GM() / (r*r*r)); }
 	inline double omega_i(size_t i) const { return omega_R(R()[i]); }
+	// dF/dh at the inner boundary, its accuracy follows --spacescheme
+	double dF_dh_in() const;
 	virtual double Mdot_in() const;
 	virtual double Lbol_disk() const;
 	double phase_opt() const;
@@ -334,6 +480,11 @@ public:
 // opt_str_
 protected:
 	virtual void invalidate_optional_structure();
+	virtual void truncate_optional_structure(size_t old_last);
+	// Replaces the radial grid keeping first(), nodes first()..new_last of the new grid become the hot disk.
+	// F is interpolated linearly and rescaled to conserve the hot disk mass, structure tables and wind are
+	// recalculated
+	void replace_grid(vecd&& new_h, size_t new_last);
 
 	template <DiskIntegrationRegion Region> size_t region_first() const {
 		if constexpr(Region == HotRegion) {
@@ -356,10 +507,10 @@ protected:
 	template <DiskIntegrationRegion Region> double integrate(const vecd& values) const {
 		return disk_radial_trapz(R(), values, region_first<Region>(), region_last<Region>());
 	}
-	template <DiskIntegrationRegion Region> double integrate(const std::function<double (size_t)>& func) const {
+	template <DiskIntegrationRegion Region, typename Func> double integrate(const Func& func) const {
 		return disk_radial_trapz(R(), func, region_first<Region>(), region_last<Region>());
 	}
-	template <DiskIntegrationRegion Region> double integrate(const vecd& x, const std::function<double (size_t)>& func) const {
+	template <DiskIntegrationRegion Region, typename Func> double integrate(const vecd& x, const Func& func) const {
 		return trapz(x, func, region_first<Region>(), region_last<Region>());
 	}
 	template <DiskIntegrationRegion Region> double lazy_integrate(boost::optional<double>& x, const vecd& values) {
@@ -368,27 +519,72 @@ protected:
 		}
 		return *x;
 	}
-	template<DiskIntegrationRegion Region> double lazy_integrate(boost::optional<double> &opt, const vecd& x, const std::function<double (size_t)>& values) {
+	template <DiskIntegrationRegion Region, typename Func> double lazy_integrate(boost::optional<double> &opt, const vecd& x, const Func& values) {
 		if (!opt) {
 			opt = integrate<Region>(x, values);
 		}
 		return *opt;
 	}
-	template <DiskIntegrationRegion Region> double I_lambda(double lambda) {
-		const vecd* T;
+	template <DiskIntegrationRegion Region> const vecd& region_T() {
 		if constexpr(Region == HotRegion) {
-			T = &Tph();
+			return Tph();
 		} else if constexpr(Region == ColdRegion) {
-			T = &Tirr();
+			return Tirr();
 		} else {
 			static_assert("Wrong Region template argument");
 		}
-		return integrate<Region>([T, lambda](const size_t i) -> double { return Spectrum::Planck_lambda((*T)[i], lambda); });
 	}
+	template <DiskIntegrationRegion Region> double I_lambda(double lambda) {
+		const vecd& T = region_T<Region>();
+		return integrate<Region>([&T, lambda](const size_t i) -> double { return Spectrum::Planck_lambda(T[i], lambda); });
+	}
+	template <DiskIntegrationRegion Region> void I_lambda(const vecd& lambdas, vecd& I) {
+		Spectrum::disk_radial_Planck_lambda(R(), region_T<Region>(), region_first<Region>(), region_last<Region>(), lambdas, I);
+	}
+	template <DiskIntegrationRegion Region> const vecd& lazy_intensities(LazyArray& intensities);
+	const std::vector<std::vector<vecd>>& lazy_star_fluxes();
+	// Lx and Lx_bands are integrated together in a single pass over Tph_X()
+	void lazy_xray_luminosities();
 	double lazy_magnitude(boost::optional<double>& m, double lambda, double F0);
-	virtual const vecd& Qx();
+	// Height, Kirr, Qx, Tirr and Tph are calculated together in a single pass over the radial grid,
+	// irr_luminosity(mu) is the luminosity of the central source(s) times the angular distribution(s) of their
+	// radiation, mu = Height / R. Only cells of [begin, end) are (re)calculated
+	template <typename IrrLuminosity> void fused_irradiation(const IrrLuminosity& irr_luminosity, const size_t begin, const size_t end) {
+		const vecd& Tvis = Tph_vis();
+		if (!opt_str_.Height) {
+			for (auto x : {&opt_str_.Height, &opt_str_.Kirr, &opt_str_.Qx, &opt_str_.Tirr, &opt_str_.Tph}) {
+				x->emplace(Nx());
+			}
+		}
+		vecd& H = *opt_str_.Height;
+		vecd& K = *opt_str_.Kirr;
+		vecd& Q = *opt_str_.Qx;
+		vecd& T_irr = *opt_str_.Tirr;
+		vecd& T_ph = *opt_str_.Tph;
+		auto irradiation = [&](const size_t i) {
+			Q[i] = K[i] * irr_luminosity(H[i] / R()[i]) * str_->Qx_factor[i];
+			T_irr[i] = std::pow(Q[i] / GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT, 0.25);
+			T_ph[i] = std::pow(m::pow<4>(Tvis[i]) + Q[i] / GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT, 0.25);
+		};
+		for (size_t i = begin; i < std::min(end, last() + 1); i++) {
+			H[i] = str_->Height_factor[i] * std::pow(F()[i], oprel().Height_exp_F);
+			K[i] = args().irr->Cirr * std::pow(H[i] * str_->Kirr_factor[i], args().irr->irrindex);
+			irradiation(i);
+		}
+		// Height / R is constant for the cold disk
+		const double Kirr_cold = args().irr->Cirr_cold * std::pow(args().irr->height_to_radius_cold / 0.05, args().irr->irrindex_cold);
+		for (size_t i = std::max(begin, last() + 1); i < end; i++) {
+			H[i] = args().irr->height_to_radius_cold * R()[i];
+			K[i] = Kirr_cold;
+			irradiation(i);
+		}
+	}
+	virtual void calculate_irradiation(size_t begin, size_t end);
+	const vecd& Qx();
 public:
 	double Lx();
+	// X-ray luminosities of the disk in the bands of args().flux->xbands, computed in the same pass over Tph_X() as Lx()
+	const vecd& Lx_bands();
 	const vecd& W();
 	const vecd& Sigma();
 	const vecd& Tph();
@@ -405,27 +601,85 @@ public:
 		return I_lambda<Region>(lambda) * m::pow<2>(lambda) / GSL_CONST_CGSM_SPEED_OF_LIGHT * cosiOverD2();
 	}
 	template <DiskIntegrationRegion Region> double flux_region(const Passband& passband) {
+		vecd I;
+		I_lambda<Region>(passband.lambdas, I);
 		const double intens = trapz(
 				passband.lambdas,
-				[this, &passband](const size_t i) -> double {
-					return I_lambda<Region>(passband.lambdas[i]) * passband.transmissions[i];
+				[&I, &passband](const size_t i) -> double {
+					return I[i] * passband.transmissions[i];
 				},
 				0,
 				passband.data.size() - 1);
 		return intens * cosiOverD2() / passband.t_dnu;
 	}
+	// Fluxes for all wavelengths of lambdas are calculated in a single pass over the disk and written into fluxes
+	template <DiskIntegrationRegion Region> void spectrum_region(const vecd& lambdas, vecd& fluxes) {
+		spectrum_region<Region>(lambdas, fluxes, cosiOverD2());
+	}
+	// The same for an observer with given cos(i) / d^2
+	template <DiskIntegrationRegion Region> void spectrum_region(const vecd& lambdas, vecd& fluxes, const double cosi_over_d2) {
+		I_lambda<Region>(lambdas, fluxes);
+		for (size_t j = 0; j < lambdas.size(); ++j) {
+			fluxes[j] *= m::pow<2>(lambdas[j]) / GSL_CONST_CGSM_SPEED_OF_LIGHT * cosi_over_d2;
+		}
+	}
+	template <DiskIntegrationRegion Region> vecd spectrum_region(const vecd& lambdas, const ObserverGeometry& observer) {
+		vecd fluxes;
+		spectrum_region<Region>(lambdas, fluxes, observer.cosiOverD2);
+		return fluxes;
+	}
+	template <DiskIntegrationRegion Region> vecd spectrum_region(const vecd& lambdas) {
+		vecd fluxes;
+		spectrum_region<Region>(lambdas, fluxes);
+		return fluxes;
+	}
 	inline double flux(const double lambda) { return flux_region<HotRegion>(lambda); }
 	inline double flux(const Passband& passband) { return flux_region<HotRegion>(passband); }
+	inline void spectrum(const vecd& lambdas, vecd& fluxes) { spectrum_region<HotRegion>(lambdas, fluxes); }
+	inline vecd spectrum(const vecd& lambdas) { return spectrum_region<HotRegion>(lambdas); }
 	double flux_star(double lambda, double phase);
 	double flux_star(const Passband& passband, double phase);
 	inline double flux_star(double lambda) { return flux_star(lambda, phase_opt()); }
 	inline double flux_star(const Passband& passband) { return flux_star(passband, phase_opt()); }
+	// Star fluxes for all wavelengths and passbands in all phases in a single pass over the star surface,
+	// result is indexed as [phase][band], where lambdas go first and passbands follow them
+	std::vector<vecd> flux_star(const vecd& lambdas, const std::vector<Passband>& passbands, const vecd& phases);
+	inline vecd spectrum_star(const vecd& lambdas, const double phase) { return flux_star(lambdas, {}, {phase})[0]; }
+	// Star fluxes for every observer in a single pass over the star surface, result is indexed as [observer][phase][band]
+	std::vector<std::vector<vecd>> flux_star(const vecd& lambdas, const std::vector<Passband>& passbands, const vecd& phases,
+			const std::vector<ObserverGeometry>& observers);
+	inline vecd spectrum_star(const vecd& lambdas, const double phase, const ObserverGeometry& observer) {
+		return flux_star(lambdas, {}, {phase}, {observer})[0][0];
+	}
+	// Observer-independent spectral intensities of the hot or cold disk integrated over its surface, for lambdas() and
+	// then passbands of args().flux, so spectral flux density is Inu cos(i) / d^2. They are calculated in a single pass
+	// over the disk and shared by all observers()
+	const vecd& Inu();
+	const vecd& Inu_cold();
+	// Disk and star spectral flux densities for the main observer, bands are indexed as in Inu()
+	inline double Fnu(const size_t i_band) { return Inu()[i_band] * cosiOverD2(); }
+	inline double Fnu_cold(const size_t i_band) { return Inu_cold()[i_band] * cosiOverD2(); }
+	// Star fluxes in phases phase_opt(), 0 and pi, indexed as [phase][band]. They are calculated in a single pass over
+	// the star surface for the main observer and all observers()
+	inline const std::vector<vecd>& Fnu_star() { return lazy_star_fluxes()[0]; }
+	// The same for the observer observers()[i_obs]
+	inline double Fnu_observer(const size_t i_obs, const size_t i_band) { return Inu()[i_band] * observers()[i_obs].cosiOverD2; }
+	inline double Fnu_cold_observer(const size_t i_obs, const size_t i_band) { return Inu_cold()[i_band] * observers()[i_obs].cosiOverD2; }
+	inline const std::vector<vecd>& Fnu_star_observer(const size_t i_obs) { return lazy_star_fluxes()[i_obs + 1]; }
 	inline double Mdisk() { return lazy_integrate<HotRegion>(opt_str_.Mdisk, Sigma()); }
 	double Mdot_wind();
 	double Sigma_minus(double r) const;
 	double Sigma_plus(double r) const;
+	inline const vecd& Sigma_minus() const { return str_->Sigma_minus; }
+	inline const vecd& Sigma_plus() const { return str_->Sigma_plus; }
 	double R_cooling_front(double r);
 	double v_cooling_front(double r);
+	// Cooling-front velocity at R()[i] from the precomputed profiles, log_Sigma_out = log(Sigma()[last()])
+	inline double v_cooling_front(const size_t i, const double log_Sigma_out) const {
+		const double sigma = (log_Sigma_out - str_->log_Sigma_plus[i]) / str_->log_Sigma_minus_over_plus[i];
+		return str_->v_cooling_front_factor[i] * DiskStructure::v_cooling_front_sigma_polynomial(sigma)
+			* std::exp(str_->v_cooling_front_sigma_exp * sigma);
+	}
 };
 
 #endif //FREDDI_FREDDI_STATE_HPP
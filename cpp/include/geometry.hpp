@@ -10,11 +10,6 @@
 class Vec3 {
 protected:
 	std::array<double, 3> cartesian_;
-	double length_;
-private:
-	static double lengthFromCartesian(const std::array<double, 3>& cartesian);
-protected:
-	Vec3(const std::array<double, 3>& cartesian, double length);
 public:
 	explicit Vec3(const std::array<double, 3>& cartesian);
 	Vec3(double x, double y, double z);
@@ -23,7 +18,9 @@ public:
 	double x() const;
 	double y() const;
 	double z() const;
+	// Length isn't stored, every call costs a square root, use squaredLength() where it is enough
 	double length() const;
+	double squaredLength() const;
 	const std::array<double, 3>& cartesian() const;
 	bool operator==(const Vec3& other) const;
 	bool operator!=(const Vec3& other) const;
@@ -45,7 +42,12 @@ private:
 	static std::array<double, 3> cartesianFromSpherical(double theta, double phi);
 public:
 	explicit UnitVec3(const Vec3& vec3);
+	// vec3_length must be equal to vec3.length(), it is used to avoid the second square root calculation
+	UnitVec3(const Vec3& vec3, double vec3_length);
 	UnitVec3(double theta, double phi);
+public:
+	inline double length() const { return 1.0; }
+	inline double squaredLength() const { return 1.0; }
 };
 
 
@@ -55,6 +57,8 @@ protected:
 	double area_;
 	Vec3 center_;
 	UnitVec3 normal_;
+private:
+	Triangle(const std::array<Vec3, 3>& vertices, const Vec3& doubled_area_normal);
 public:
 	Triangle(std::array<Vec3, 3>&& vertices);
 	Triangle(const std::array<Vec3, 3>& vertices);
@@ -0,0 +1,151 @@
+#ifndef FREDDI_MPI_SWEEP_HPP
+#define FREDDI_MPI_SWEEP_HPP
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+#include <boost/program_options.hpp>
+
+#include "options.hpp"
+#include "sweep.hpp"
+
+namespace po = boost::program_options;
+
+
+namespace mpi_sweep {
+const int master = 0;
+// a worker sends a result or an empty message when it is ready for the first parameter set
+const int tag_result = 1;
+// the master sends a parameter set as the number of the set and the line separated by a newline
+const int tag_task = 2;
+const int tag_stop = 3;
+
+inline void send(const std::string& message, const int destination, const int tag) {
+	MPI_Send(message.data(), static_cast<int>(message.size()), MPI_CHAR, destination, tag, MPI_COMM_WORLD);
+}
+
+inline std::string receive(const int source, const int tag, MPI_Status& status) {
+	MPI_Probe(source, tag, MPI_COMM_WORLD, &status);
+	int size;
+	MPI_Get_count(&status, MPI_CHAR, &size);
+	std::string message(size, '\0');
+	MPI_Recv(&message[0], size, MPI_CHAR, status.MPI_SOURCE, status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+	return message;
+}
+
+// Gives parameter sets to workers one by one as they become free, because run times of the sets differ a lot, and
+// gathers their results. If there are no workers the master calculates parameter sets itself
+template <typename Output, typename Options, typename Evolution>
+bool run_master(const int n_workers, std::unique_ptr<SweepParameterSets> sets, const SweepOptions& sweep,
+				const po::options_description& desc, const std::vector<po::parsed_options>& sources) {
+	std::unique_ptr<SweepStore> store;
+	if (sets) {
+		try {
+			store.reset(new SweepStore(sweep));
+		} catch (const std::runtime_error& e) {
+			std::cerr << "Error: " << e.what() << std::endl;
+			sets.reset();
+		}
+	}
+	size_t model = 0;
+	std::string line;
+	try {
+		if (n_workers == 0) {
+			while (sets && sets->next(line)) {
+				store->write(sweep_result<Output, Options, Evolution>(++model, line, sweep, desc, sources));
+			}
+		}
+		for (int active = n_workers; active > 0; ) {
+			MPI_Status status;
+			const std::string result = receive(MPI_ANY_SOURCE, tag_result, status);
+			if (!result.empty()) {
+				store->write(result);
+			}
+			if (sets && sets->next(line)) {
+				send(std::to_string(++model) + "\n" + line, status.MPI_SOURCE, tag_task);
+			} else {
+				send("", status.MPI_SOURCE, tag_stop);
+				--active;
+			}
+		}
+	} catch (const std::exception& e) {
+		// e.g. a malformed result, the workers would wait for the master forever, so the whole job is aborted
+		std::cerr << "Error: " << e.what() << std::endl;
+		MPI_Abort(MPI_COMM_WORLD, 1);
+		return false;
+	}
+	if (!store) {
+		return false;
+	}
+	std::cerr << model << " parameter sets calculated, " << store->failed() << " failed" << std::endl;
+	return true;
+}
+
+template <typename Output, typename Options, typename Evolution>
+void run_worker(const SweepOptions& sweep, const po::options_description& desc,
+				const std::vector<po::parsed_options>& sources) {
+	send("", master, tag_result);
+	for (;;) {
+		MPI_Status status;
+		const std::string task = receive(master, MPI_ANY_TAG, status);
+		if (status.MPI_TAG == tag_stop) {
+			return;
+		}
+		const size_t newline = task.find('\n');
+		const size_t model = std::stoul(task.substr(0, newline));
+		send(sweep_result<Output, Options, Evolution>(model, task.substr(newline + 1), sweep, desc, sources), master, tag_result);
+	}
+}
+} // namespace mpi_sweep
+
+
+// Calculates parameter sets of --list or --grid on MPI processes: the first process distributes the sets and writes
+// results, the others calculate them. Every process parses the command line and configuration files once
+template <typename Output, typename Options, typename Evolution>
+bool run_sweep(int ac, char *av[]) {
+	MPI_Init(&ac, &av);
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	auto desc = Options::description();
+	desc.add(SweepOptions::description());
+	std::vector<po::parsed_options> sources;
+	po::variables_map vm;
+	std::unique_ptr<SweepOptions> sweep;
+	std::unique_ptr<SweepParameterSets> sets;
+	try {
+		// required options can be given by parameter sets, they are checked for every parameter set
+		if (parseOptions<Options>(vm, sources, desc, ac, av, false)) {
+			sweep.reset(new SweepOptions(vm));
+		}
+		if (sweep && rank == mpi_sweep::master) {
+			sets.reset(new SweepParameterSets(*sweep));
+		}
+	} catch (const po::error& e) {
+		if (rank == mpi_sweep::master) {
+			std::cerr << "Error: " << e.what() << std::endl;
+		}
+	}
+
+	// all processes have the same options, so they all stop here if options are wrong
+	if (!sweep) {
+		MPI_Finalize();
+		return false;
+	}
+	bool ok = true;
+	if (rank == mpi_sweep::master) {
+		// the list file is read by the master only, without sets it just stops the workers
+		ok = mpi_sweep::run_master<Output, Options, Evolution>(size - 1, std::move(sets), *sweep, desc, sources);
+	} else {
+		mpi_sweep::run_worker<Output, Options, Evolution>(*sweep, desc, sources);
+	}
+	MPI_Finalize();
+	return ok;
+}
+
+#endif //FREDDI_MPI_SWEEP_HPP
@@ -16,6 +16,431 @@ double mean_square_rel(const vecd &A, const vecd &B, size_t first, size_t last);
 double max_dif_rel(const vecd &A, const vecd &B, size_t first, size_t last);
 
 
+// W-provider of the templated solver is any type with method
+//     double w(size_t i, double y) const
+// returning w(x_i, y), so the w(y) law can be inlined into the Picard iterations. The grid is passed for the
+// VectorWunction overload only
+template <typename WProvider>
+inline void nonlinear_diffusion_w(const WProvider& w_provider, const vecd&, const vecd& y, size_t first, size_t last, vecd& W) {
+	for (size_t i = first; i <= last; ++i) {
+		W[i] = w_provider.w(i, y[i]);
+	}
+}
+
+
+// Adapter for the std::function API, wunc returns the whole array of w(x_i,y_i)
+struct VectorWunction {
+	const std::function<vecd (const vecd &, const vecd &, size_t, size_t)>& wunc;
+};
+
+inline void nonlinear_diffusion_w(const VectorWunction& w_provider, const vecd& x, const vecd& y, size_t first, size_t last, vecd& W) {
+	W = w_provider.wunc(x, y, first, last);
+}
+
+
+// \frac{dw}{dt}=\frac{d^2y}{dx^2} + A\frac{dy}{dx} + By + C, y=y(x,t) — ?, w = w (x,y)
+
+// Three-point approximation of the right-hand side: (a_i y_{i-1} + b_i y_{i+1} - c0_i y_i) / d_i + C_i,
+// the right boundary node uses half a cell, its b_i is replaced by the flux condition
+inline void nonlinear_diffusion_coefficients(
+		const vecd &A, const vecd &B, const vecd &x,
+		size_t first, size_t last,
+		vecd &a, vecd &b, vecd &c0, vecd &d
+) {
+	a.resize(last + 1);
+	b.resize(last + 1);
+	c0.resize(last + 1);
+	d.assign(last + 1, 0.);
+	for (size_t i = first + 1; i <= last - 1; ++i) {
+		a[i] = (x[i + 1] - x[i]) / (x[i + 1] - x[i - 1]) * (2.0 - A[i] * (x[i + 1] - x[i]));
+		b[i] = (x[i] - x[i - 1]) / (x[i + 1] - x[i - 1]) * (2.0 + A[i] * (x[i] - x[i - 1]));
+		c0[i] = 2.0 - A[i] * (x[i + 1] - 2 * x[i] + x[i - 1]) - B[i] * (x[i + 1] - x[i]) * (x[i] - x[i - 1]);
+		d[i] = (x[i + 1] - x[i]) * (x[i] - x[i - 1]);
+	}
+	a[last] = 1 - 0.5 * A[last] * (x[last] - x[last - 1]);
+	c0[last] = a[last] - 0.5 * B[last] * (x[last] - x[last - 1]) * (x[last] - x[last - 1]);
+	d[last] = (x[last] - x[last - 1]) * (x[last] - x[last - 1]) * 0.5;
+}
+
+
+// Implicit Euler step (W_new - W) / tau = RHS(y_new), solved by Picard iterations.
+// W is w(x,y) at the previous time level on input and w(x,y_new) on output.
+// If lagged_boundary is true, then the Picard coefficient W / y of the right boundary node is not iterated and
+// is taken from the input, it is valid only if the input W is w(x,y)
+template <typename WProvider>
+void nonlinear_diffusion_implicit_step (
+		const double tau,
+		const double eps, // relative error for w
+		const double left_bounder_cond, // y(left_border,Time+tau) = left_bounder_cond
+		const double right_bounder_cond, // \frac{y(right_border,Time+tau)}{dx} = right_bounder_cond
+		const vecd &A,
+		const vecd &B,
+		const vecd &C,
+		const WProvider& w_provider, // see nonlinear_diffusion_w
+		const vecd &x, // array with (non)uniform grid
+		vecd &y, // array with initial condition and for results
+		vecd &W,
+		size_t first, size_t last, // indexes of front and back elements
+		const bool lagged_boundary = true
+) {
+	vecd K_0(last + 1), K_1(last + 1), frac(last + 1), a, b, c0, f(last + 1);
+	nonlinear_diffusion_coefficients(A, B, x, first, last, a, b, c0, frac);
+	for (size_t i = first + 1; i <= last; ++i) {
+		frac[i] /= tau;
+	}
+	for (size_t i = first + 1; i <= last; ++i) {
+		f[i] = frac[i] * (W[i] + tau * C[i]);
+	}
+	for (size_t i = first + 1; i <= last - 1; ++i) {
+		K_1[i] = f[i] / y[i];
+	}
+	K_1[last] = frac[last] * W[last] / y[last];
+
+	vecd alpha(last + 1), beta(last + 1);
+	double c;
+	do {
+		K_0 = K_1;
+		alpha[first + 1] = 0.;
+		beta[first + 1] = left_bounder_cond;
+		for (size_t i = first + 1; i <= last - 1; ++i) {
+			c = c0[i] + K_1[i];
+			alpha[i + 1] = b[i] / (c - alpha[i] * a[i]);
+			beta[i + 1] = (beta[i] * a[i] + f[i]) / (c - alpha[i] * a[i]);
+		}
+		y[last] = ((x[last] - x[last - 1]) * right_bounder_cond + f[last] + beta[last] * a[last]) /
+				   (c0[last] + K_1[last] - alpha[last] * a[last]);
+		for (size_t i = last - 1; i > first; --i) {
+			y[i] = alpha[i + 1] * y[i + 1] + beta[i + 1];
+		}
+		y[first] = left_bounder_cond;
+		nonlinear_diffusion_w(w_provider, x, y, first + 1, last, W);
+		for (size_t i = 1; i <= last - 1; ++i) {
+			K_1[i] = frac[i] * W[i] / y[i];
+		}
+		if (!lagged_boundary) {
+			K_1[last] = frac[last] * W[last] / y[last];
+		}
+	} while (max_dif_rel(K_1, K_0, 1, lagged_boundary ? last - 1 : last) > eps);
+}
+
+
+// First order in time: implicit Euler
+template <typename WProvider>
+void nonlinear_diffusion_nonuniform_wind_1_2 (
+		const double tau,
+		const double eps, // relative error for w
+		const double left_bounder_cond, // y(left_border,Time+tau) = left_bounder_cond
+		const double right_bounder_cond, // \frac{y(right_border,Time+tau)}{dx} = right_bounder_cond
+		const vecd &A,
+		const vecd &B,
+		const vecd &C,
+		const WProvider& w_provider, // see nonlinear_diffusion_w
+		const vecd &x, // array with (non)uniform grid
+		vecd &y, // array with initial condition and for results
+		size_t first, size_t last // indexes of front and back elements
+) {
+	vecd W(last + 1, 0.);
+	nonlinear_diffusion_w(w_provider, x, y, first + 1, last, W);
+	nonlinear_diffusion_implicit_step(tau, eps, left_bounder_cond, right_bounder_cond, A, B, C, w_provider, x, y, W, first, last);
+}
+
+
+// Adds tau times the three-point approximation of the right-hand side at y to W
+inline void nonlinear_diffusion_explicit_increment(
+		const double tau,
+		const double right_bounder_cond,
+		const vecd &A, const vecd &B, const vecd &C,
+		const vecd &x, const vecd &y, vecd &W,
+		size_t first, size_t last
+) {
+	vecd a, b, c0, d;
+	nonlinear_diffusion_coefficients(A, B, x, first, last, a, b, c0, d);
+	for (size_t i = first + 1; i <= last - 1; ++i) {
+		W[i] += tau * ((a[i] * y[i - 1] + b[i] * y[i + 1] - c0[i] * y[i]) / d[i] + C[i]);
+	}
+	W[last] += tau * (((x[last] - x[last - 1]) * right_bounder_cond + a[last] * y[last - 1] - c0[last] * y[last]) / d[last] + C[last]);
+}
+
+
+// Solves tridiagonal system lower_i z_{i-1} + diag_i z_i + upper_i z_{i+1} = rhs_i, i = first..last.
+// The last row can have one more element last_lower2 z_{last-2}, last - 2 >= first
+inline void solve_tridiagonal(const vecd &lower, const vecd &diag, const vecd &upper, const vecd &rhs, size_t first, size_t last, vecd &z, const double last_lower2 = 0.) {
+	vecd c(last + 1), r(last + 1);
+	c[first] = upper[first] / diag[first];
+	r[first] = rhs[first] / diag[first];
+	for (size_t i = first + 1; i <= last; ++i) {
+		double l = lower[i];
+		double f = rhs[i];
+		if (i == last && last_lower2 != 0.) {
+			l -= last_lower2 * c[i - 2];
+			f -= last_lower2 * r[i - 2];
+		}
+		const double denominator = diag[i] - l * c[i - 1];
+		c[i] = upper[i] / denominator;
+		r[i] = (f - l * r[i - 1]) / denominator;
+	}
+	z[last] = r[last];
+	for (size_t i = last; i > first; --i) {
+		z[i - 1] = r[i - 1] - c[i - 1] * z[i];
+	}
+}
+
+
+// Compact (Numerov-type) scheme: sum_j m_ij dw_j/dt = sum_j d_ij y_j + e_i, j = i-1, i, i+1. Interior rows are exact
+// for fourth-degree polynomials, so they are fourth-order on smoothly stretched grids. The right boundary row
+// (y_{l-1} - y_l) / p + y'_l = g_0 y''_l + g_1 y''_{l-1} + g_2 y''_{l-2} is exact for fourth-degree polynomials too,
+// its elements of the column l-2 are m_l2 and d_l2, g_2 = 0 if there is the only interval. The A term is second-order
+inline void nonlinear_diffusion_compact_coefficients(
+		const double right_bounder_cond,
+		const vecd &A, const vecd &B, const vecd &C, const vecd &x,
+		size_t first, size_t last,
+		vecd &m_l, vecd &m_d, vecd &m_u, vecd &d_l, vecd &d_d, vecd &d_u, vecd &e,
+		double &m_l2, double &d_l2
+) {
+	for (vecd* v : {&m_l, &m_d, &m_u, &d_l, &d_d, &d_u, &e}) {
+		v->assign(last + 1, 0.);
+	}
+	for (size_t i = first + 1; i <= last - 1; ++i) {
+		const double p = x[i] - x[i - 1];
+		const double q = x[i + 1] - x[i];
+		const double S = 12. * p * q / (p * p + 3. * p * q + q * q);
+		m_l[i] = S * (p * p + p * q - q * q) / (12. * p * (p + q));
+		m_d[i] = 1.;
+		m_u[i] = S * (q * q + p * q - p * p) / (12. * q * (p + q));
+		const double s = S / (q * (p + q));
+		const double sigma = m_l[i] + m_d[i] + m_u[i];
+		d_l[i] = s * q / p + m_l[i] * B[i - 1] - sigma * A[i] * q / (p * (p + q));
+		d_d[i] = -s * (q / p + 1.) + B[i] + sigma * A[i] * (q - p) / (p * q);
+		d_u[i] = s + m_u[i] * B[i + 1] + sigma * A[i] * p / (q * (p + q));
+		e[i] = m_l[i] * C[i - 1] + C[i] + m_u[i] * C[i + 1];
+	}
+
+	const double p = x[last] - x[last - 1];
+	double g_0 = p / 3., g_1 = p / 6., g_2 = 0.;
+	if (last >= first + 2) {
+		const double r = x[last - 1] - x[last - 2];
+		g_2 = -p * p * p / (12. * (p + r) * r);
+		g_1 = p / 6. + p * p / (12. * r);
+		g_0 = 0.5 * p - g_1 - g_2;
+	}
+	m_l2 = g_2;
+	m_l[last] = g_1;
+	m_d[last] = g_0;
+	d_l[last] = 1. / p + g_1 * B[last - 1];
+	d_d[last] = -1. / p + g_0 * B[last];
+	d_l2 = last >= first + 2 ? g_2 * B[last - 2] : 0.;
+	e[last] = right_bounder_cond + g_0 * C[last] + g_1 * C[last - 1] + (last >= first + 2 ? g_2 * C[last - 2] : 0.);
+	// y' near the boundary is taken from the parabola through y_{l-1} and y_l with y'_l = right_bounder_cond,
+	// y'(x_l - delta) = right_bounder_cond - 2 delta (y_{l-1} - y_l + p right_bounder_cond) / p^2
+	const double gA_delta = g_1 * A[last - 1] * p + (last >= first + 2 ? g_2 * A[last - 2] * (x[last] - x[last - 2]) : 0.);
+	const double gA = g_0 * A[last] + g_1 * A[last - 1] + (last >= first + 2 ? g_2 * A[last - 2] : 0.);
+	d_l[last] -= 2. * gA_delta / (p * p);
+	d_d[last] += 2. * gA_delta / (p * p);
+	e[last] += (gA - 2. * gA_delta / p) * right_bounder_cond;
+}
+
+
+// Adds tau times the compact approximation of the right-hand side at y to W, see nonlinear_diffusion_compact_coefficients
+inline void nonlinear_diffusion_compact_explicit_increment(
+		const double tau,
+		const double right_bounder_cond,
+		const vecd &A, const vecd &B, const vecd &C,
+		const vecd &x, const vecd &y, vecd &W,
+		size_t first, size_t last
+) {
+	vecd m_l, m_d, m_u, d_l, d_d, d_u, e;
+	double m_l2, d_l2;
+	nonlinear_diffusion_compact_coefficients(right_bounder_cond, A, B, C, x, first, last, m_l, m_d, m_u, d_l, d_d, d_u, e, m_l2, d_l2);
+	vecd rhs(last + 1), z(last + 1);
+	for (size_t i = first + 1; i <= last; ++i) {
+		rhs[i] = d_l[i] * y[i - 1] + d_d[i] * y[i] + e[i];
+		if (i < last) {
+			rhs[i] += d_u[i] * y[i + 1];
+		}
+	}
+	const bool column_l2 = last >= first + 3;
+	if (last >= first + 2) {
+		rhs[last] += d_l2 * y[last - 2];
+	}
+	solve_tridiagonal(m_l, m_d, m_u, rhs, first + 1, last, z, column_l2 ? m_l2 : 0.);
+	for (size_t i = first + 1; i <= last; ++i) {
+		W[i] += tau * z[i];
+	}
+}
+
+
+// Implicit Euler step of the compact scheme, see nonlinear_diffusion_implicit_step.
+// Unlike the three-point scheme, W[first] is used: it is w(x,y) at the previous time level on input
+template <typename WProvider>
+void nonlinear_diffusion_compact_implicit_step (
+		const double tau,
+		const double eps, // relative error for w
+		const double left_bounder_cond, // y(left_border,Time+tau) = left_bounder_cond
+		const double right_bounder_cond, // \frac{y(right_border,Time+tau)}{dx} = right_bounder_cond
+		const vecd &A,
+		const vecd &B,
+		const vecd &C,
+		const WProvider& w_provider, // see nonlinear_diffusion_w
+		const vecd &x, // array with (non)uniform grid
+		vecd &y, // array with initial condition and for results
+		vecd &W,
+		size_t first, size_t last // indexes of front and back elements
+) {
+	vecd m_l, m_d, m_u, d_l, d_d, d_u, e;
+	double m_l2, d_l2;
+	nonlinear_diffusion_compact_coefficients(right_bounder_cond, A, B, C, x, first, last, m_l, m_d, m_u, d_l, d_d, d_u, e, m_l2, d_l2);
+	const bool column_l2 = last >= first + 3;
+	const vecd W_old(W);
+	vecd f(last + 1);
+	for (size_t i = first + 1; i <= last; ++i) {
+		f[i] = tau * e[i] + m_l[i] * W_old[i - 1] + m_d[i] * W_old[i];
+		if (i < last) {
+			f[i] += m_u[i] * W_old[i + 1];
+		}
+	}
+	if (last >= first + 2) {
+		f[last] += m_l2 * W_old[last - 2];
+	}
+	// y and w at the inner boundary are known at the new time level
+	y[first] = left_bounder_cond;
+	nonlinear_diffusion_w(w_provider, x, y, first, last, W);
+	f[first + 1] += tau * d_l[first + 1] * left_bounder_cond - m_l[first + 1] * W[first];
+	if (last == first + 2) {
+		f[last] += tau * d_l2 * left_bounder_cond - m_l2 * W[first];
+	}
+
+	vecd K_0(last + 1), K_1(last + 1), lower(last + 1), diag(last + 1), upper(last + 1);
+	for (size_t i = first + 1; i <= last; ++i) {
+		K_1[i] = W[i] / y[i];
+	}
+	do {
+		K_0 = K_1;
+		for (size_t i = first + 1; i <= last; ++i) {
+			lower[i] = i > first + 1 ? m_l[i] * K_1[i - 1] - tau * d_l[i] : 0.;
+			diag[i] = m_d[i] * K_1[i] - tau * d_d[i];
+			upper[i] = i < last ? m_u[i] * K_1[i + 1] - tau * d_u[i] : 0.;
+		}
+		solve_tridiagonal(lower, diag, upper, f, first + 1, last, y, column_l2 ? m_l2 * K_1[last - 2] - tau * d_l2 : 0.);
+		nonlinear_diffusion_w(w_provider, x, y, first, last, W);
+		for (size_t i = first + 1; i <= last; ++i) {
+			K_1[i] = W[i] / y[i];
+		}
+	} while (max_dif_rel(K_1, K_0, first + 1, last) > eps);
+}
+
+
+// TR-BDF2, the trapezoidal rule up to Time + gamma tau followed by BDF2 over Time, Time + gamma tau and Time + tau.
+// It is L-stable and needs two implicit solutions per step. Boundary conditions and A, B, C are the same for both
+// stages. The explicit half of the trapezoidal rule can make w non-positive where the step is too large for the local
+// diffusion time, e.g. at the very edge of a vanishing disk, then the whole step falls back to implicit Euler.
+// implicit_step(tau, W) and explicit_increment(tau, W) implement the spatial scheme
+template <typename WProvider, typename ImplicitStep, typename ExplicitIncrement>
+void nonlinear_diffusion_trbdf2 (
+		const double tau,
+		const WProvider& w_provider,
+		const vecd &x, vecd &y,
+		size_t first, size_t last,
+		const ImplicitStep& implicit_step,
+		const ExplicitIncrement& explicit_increment
+) {
+	constexpr double gamma = 2. - M_SQRT2;
+	const double tau_tr = 0.5 * gamma * tau;
+	const double tau_bdf = (1. - gamma) / (2. - gamma) * tau;
+
+	vecd W(last + 1, 0.);
+	nonlinear_diffusion_w(w_provider, x, y, first, last, W);
+	const vecd W_0(W);
+
+	explicit_increment(tau_tr, W);
+	for (size_t i = first + 1; i <= last; ++i) {
+		if (!(W[i] > 0.)) {
+			W = W_0;
+			implicit_step(tau, W);
+			return;
+		}
+	}
+	implicit_step(tau_tr, W);
+
+	for (size_t i = first; i <= last; ++i) {
+		W[i] = (W[i] - (1. - gamma) * (1. - gamma) * W_0[i]) / (gamma * (2. - gamma));
+	}
+	implicit_step(tau_bdf, W);
+}
+
+
+// Second order in time, second order in space, see nonlinear_diffusion_trbdf2
+template <typename WProvider>
+void nonlinear_diffusion_nonuniform_wind_2_2 (
+		const double tau,
+		const double eps, // relative error for w
+		const double left_bounder_cond, // y(left_border,Time+tau) = left_bounder_cond
+		const double right_bounder_cond, // \frac{y(right_border,Time+tau)}{dx} = right_bounder_cond
+		const vecd &A,
+		const vecd &B,
+		const vecd &C,
+		const WProvider& w_provider, // see nonlinear_diffusion_w
+		const vecd &x, // array with (non)uniform grid
+		vecd &y, // array with initial condition and for results
+		size_t first, size_t last // indexes of front and back elements
+) {
+	nonlinear_diffusion_trbdf2(
+			tau, w_provider, x, y, first, last,
+			[&](const double tau_stage, vecd &W) {
+				nonlinear_diffusion_implicit_step(tau_stage, eps, left_bounder_cond, right_bounder_cond, A, B, C, w_provider, x, y, W, first, last, false);
+			},
+			[&](const double tau_stage, vecd &W) {
+				nonlinear_diffusion_explicit_increment(tau_stage, right_bounder_cond, A, B, C, x, y, W, first, last);
+			});
+}
+
+
+// First order in time, fourth order in space, see nonlinear_diffusion_compact_coefficients
+template <typename WProvider>
+void nonlinear_diffusion_nonuniform_wind_1_4 (
+		const double tau,
+		const double eps, // relative error for w
+		const double left_bounder_cond, // y(left_border,Time+tau) = left_bounder_cond
+		const double right_bounder_cond, // \frac{y(right_border,Time+tau)}{dx} = right_bounder_cond
+		const vecd &A,
+		const vecd &B,
+		const vecd &C,
+		const WProvider& w_provider, // see nonlinear_diffusion_w
+		const vecd &x, // array with (non)uniform grid
+		vecd &y, // array with initial condition and for results
+		size_t first, size_t last // indexes of front and back elements
+) {
+	vecd W(last + 1, 0.);
+	nonlinear_diffusion_w(w_provider, x, y, first, last, W);
+	nonlinear_diffusion_compact_implicit_step(tau, eps, left_bounder_cond, right_bounder_cond, A, B, C, w_provider, x, y, W, first, last);
+}
+
+
+// Second order in time, fourth order in space
+template <typename WProvider>
+void nonlinear_diffusion_nonuniform_wind_2_4 (
+		const double tau,
+		const double eps, // relative error for w
+		const double left_bounder_cond, // y(left_border,Time+tau) = left_bounder_cond
+		const double right_bounder_cond, // \frac{y(right_border,Time+tau)}{dx} = right_bounder_cond
+		const vecd &A,
+		const vecd &B,
+		const vecd &C,
+		const WProvider& w_provider, // see nonlinear_diffusion_w
+		const vecd &x, // array with (non)uniform grid
+		vecd &y, // array with initial condition and for results
+		size_t first, size_t last // indexes of front and back elements
+) {
+	nonlinear_diffusion_trbdf2(
+			tau, w_provider, x, y, first, last,
+			[&](const double tau_stage, vecd &W) {
+				nonlinear_diffusion_compact_implicit_step(tau_stage, eps, left_bounder_cond, right_bounder_cond, A, B, C, w_provider, x, y, W, first, last);
+			},
+			[&](const double tau_stage, vecd &W) {
+				nonlinear_diffusion_compact_explicit_increment(tau_stage, right_bounder_cond, A, B, C, x, y, W, first, last);
+			});
+}
+
+
 void nonlinear_diffusion_nonuniform_wind_1_2 (
 		double tau,
 		double eps, // relative error for w
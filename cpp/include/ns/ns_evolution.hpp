@@ -68,6 +68,7 @@ private:
 
 	struct NeutronStarOptionalStructure {
 		boost::optional<double> Lx_ns_rest_frame;
+		boost::optional<vecd> Lx_ns_bands_rest_frame;
 	};
 
 	class BasicNSMdotFraction {
@@ -180,6 +181,8 @@ private:
 private:
 	static std::shared_ptr<BasicNSMdotFraction> initializeNsMdotFraction(const NeutronStarArguments& args_ns);
 	static std::shared_ptr<BasicNSAccretionEfficiency> initializeNsAccretionEfficiency(const NeutronStarArguments& args_ns, const FreddiNeutronStarEvolution* freddi);
+	// Lx_ns and Lx_ns_bands are integrated together over xbands()
+	void lazy_ns_xray_luminosities();
 // ns_str_
 public:
 	inline double kappa_t(double R) const { return (*ns_str_->kappa_t)(*this, R); }
@@ -203,6 +206,9 @@ public:
 	double T_hot_spot() const;
 	double Lx_ns();
 	double Lx_ns_rest_frame();
+	// X-ray luminosities of the neutron star in the bands of args().flux->xbands
+	vecd Lx_ns_bands();
+	const vecd& Lx_ns_bands_rest_frame();
 // angular_dist_ns_
 public:
 	inline double angular_dist_ns(const double mu) { return ns_irr_source_->angular_dist(mu); }
@@ -221,12 +227,14 @@ public:
 protected:
 	virtual void invalidate_optional_structure() override;
 	virtual void truncateInnerRadius() override;
+	// The magnetosphere radius and torque depend on the accretion rate
+	virtual bool self_similar_decay_possible() const override { return false; }
 	virtual vecd windC() const override;
 	virtual IrradiatedStar::sources_t star_irr_sources() override;
+	virtual void calculate_irradiation(size_t begin, size_t end) override;
 public:
 	FreddiNeutronStarEvolution(const FreddiNeutronStarArguments& args);
 	explicit FreddiNeutronStarEvolution(const FreddiNeutronStarEvolution&) = default;
-	virtual const vecd& Qx() override;
 	virtual double Lbol_disk() const override;
 public:
 	using iterator = EvolutionIterator<FreddiNeutronStarEvolution>;
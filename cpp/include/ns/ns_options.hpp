@@ -34,7 +34,7 @@ public:
 
 class FreddiNeutronStarOptions: public FreddiNeutronStarArguments {
 public:
-	FreddiNeutronStarOptions(const po::variables_map& vm);
+	FreddiNeutronStarOptions(const po::variables_map& vm, PassbandCache* passband_cache = nullptr);
 	static po::options_description description();
 };
 
@@ -34,6 +34,8 @@ public:
 	double a0, a1, a2, k, l;
 
 	double Height(double R, double F) const;
+	// F-independent part of Height: Height(R, F) = Height_R_factor(R) * F^Height_exp_F
+	double Height_R_factor(double R) const;
 	double f_F(double xi) const;
 };
 
@@ -10,6 +10,7 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
@@ -21,6 +22,8 @@ namespace po = boost::program_options;
 
 
 class GeneralOptions: public GeneralArguments {
+protected:
+	static vecd outputTimesInitializer(const po::variables_map& vm);
 public:
 	GeneralOptions(const po::variables_map& vm);
 	static po::options_description description();
@@ -57,9 +60,12 @@ public:
 class FluxOptions: public FluxArguments {
 protected:
 	static vecd lambdasInitializer(const po::variables_map& vm);
-	static std::vector<Passband> passbandsInitializer(const po::variables_map& vm);
+	static std::vector<Passband> passbandsInitializer(const po::variables_map& vm, PassbandCache* passband_cache);
+	static std::vector<Observer> observersInitializer(const po::variables_map& vm);
+	static std::vector<EnergyBand> xbandsInitializer(const po::variables_map& vm);
 public:
-	FluxOptions(const po::variables_map& vm);
+	// Passband files are read by passband_cache if it is given
+	FluxOptions(const po::variables_map& vm, PassbandCache* passband_cache = nullptr);
 	static po::options_description description();
 };
 
@@ -67,6 +73,7 @@ public:
 class CalculationOptions: public CalculationArguments {
 protected:
 	static std::optional<double> tauInitializer(const po::variables_map& vm);
+	static std::optional<double> tauQuiescentInitializer(const po::variables_map& vm);
 public:
 	CalculationOptions(const po::variables_map& vm);
 	static po::options_description description();
@@ -75,7 +82,7 @@ public:
 
 class FreddiOptions: public FreddiArguments {
 public:
-	FreddiOptions(const po::variables_map& vm);
+	FreddiOptions(const po::variables_map& vm, PassbandCache* passband_cache = nullptr);
 	static po::options_description description();
 };
 
@@ -88,8 +95,12 @@ std::optional<T> varToOpt(const po::variables_map& vm, const std::string& name)
 }
 
 
+// Parsed command line and configuration files are appended to sources, they refer to desc and can be stored again
+// in front of other options, e.g. of a parameter set of the server. Required options are not checked if every
+// parameter set is checked instead: in --serve mode or if check_required is false
 template <typename Options>
-bool parseOptions(po::variables_map& vm, int ac, char* av[]) {
+bool parseOptions(po::variables_map& vm, std::vector<po::parsed_options>& sources, const po::options_description& desc,
+				  int ac, char* av[], const bool check_required = true) {
 	const std::string default_config_filename = "freddi.ini";
 
 	const char* xdg_config_home = getenv("XDG_CONFIG_HOME");
@@ -107,8 +118,8 @@ bool parseOptions(po::variables_map& vm, int ac, char* av[]) {
 		config_file_paths.push_back(dir + "/" + default_config_filename);
 	}
 
-	auto desc = Options::description();
-	po::store(po::parse_command_line(ac, av, desc), vm);
+	sources.push_back(po::parse_command_line(ac, av, desc));
+	po::store(sources.back(), vm);
 
 	if (vm.count("help") > 0) {
 		std::cout << desc << std::endl;
@@ -121,7 +132,12 @@ bool parseOptions(po::variables_map& vm, int ac, char* av[]) {
 
 	for (const auto &path : config_file_paths) {
 		std::ifstream config(path);
-		po::store(po::parse_config_file(config, desc), vm);
+		sources.push_back(po::parse_config_file(config, desc));
+		po::store(sources.back(), vm);
+	}
+
+	if (!check_required || vm.count("serve") > 0) {
+		return true;
 	}
 
 	try {
@@ -134,4 +150,11 @@ bool parseOptions(po::variables_map& vm, int ac, char* av[]) {
 	return true;
 }
 
+template <typename Options>
+bool parseOptions(po::variables_map& vm, int ac, char* av[]) {
+	const auto desc = Options::description();
+	std::vector<po::parsed_options> sources;
+	return parseOptions<Options>(vm, sources, desc, ac, av);
+}
+
 #endif //FREDDI_OPTIONS_HPP
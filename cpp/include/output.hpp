@@ -57,7 +57,12 @@ private:
 	FileOrStdoutStream output;
 	std::string disk_structure_header;
 	std::string star_header;
+	// Number of dump() calls before the current one
+	size_t i_dump = 0;
 	static std::string initializeFulldataHeader(const std::vector<FileOutputLongField>& fields);
+	// Suffix of --fulldata file names: time step index, or index of the output moment if output times are given,
+	// because several moments can share a time step
+	std::string fulldataSuffix() const;
 public:
 	BasicFreddiFileOutput(const std::shared_ptr<FreddiEvolution>& freddi, const boost::program_options::variables_map& vm,
 						  std::vector<FileOutputShortField>&& short_fields,
@@ -71,6 +76,11 @@ public:
 	static std::vector<FileOutputShortField> initializeShortFields(const std::shared_ptr<FreddiEvolution>& freddi);
 	static std::vector<FileOutputLongField> initializeDiskStructureFields(const std::shared_ptr<FreddiEvolution>& freddi);
 	static std::vector<FileOutputLongField> initializeStarFields(const std::shared_ptr<FreddiEvolution>& freddi);
+	// Column name suffix and description tail of the fields of the additional observer observers()[i_obs]
+	static std::string observerSuffix(size_t i_obs);
+	static std::string observerDescription(const FreddiState::ObserverGeometry& observer);
+	// Description tail of the fields of the additional X-ray band
+	static std::string xbandDescription(const EnergyBand& band);
 public:
 	FreddiFileOutput(const std::shared_ptr<FreddiEvolution>& freddi, const boost::program_options::variables_map& vm):
 			BasicFreddiFileOutput(freddi, vm, initializeShortFields(freddi), initializeDiskStructureFields(freddi),
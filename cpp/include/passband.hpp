@@ -1,6 +1,8 @@
 #ifndef FREDDI_PASSBAND_HPP
 #define FREDDI_PASSBAND_HPP
 
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -43,4 +45,15 @@ protected:
 	double bb_integral(double temp) const;
 };
 
+// Passbands read from files by path. The server owns one to read every file once for all its parameter sets, so a
+// file changed while the server runs isn't reread
+class PassbandCache {
+private:
+	std::mutex mutex;
+	std::map<std::string, Passband> passbands;
+public:
+	// The file is read on the first request of filepath
+	Passband get(const std::string& filepath);
+};
+
 #endif //FREDDI_PASSBAND_HPP
@@ -0,0 +1,245 @@
+#ifndef FREDDI_SERVER_HPP
+#define FREDDI_SERVER_HPP
+
+#include <algorithm>  // find_if sort transform
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>  // strerror
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>  // accept
+
+#include <boost/program_options.hpp>
+
+#include "freddi_evolution.hpp"
+#include "output.hpp"
+#include "passband.hpp"
+#include "unit_transformation.hpp"
+#include "util.hpp"
+
+namespace po = boost::program_options;
+
+
+// Line-oriented connection of the server. Results are written by several threads as soon as they are ready, the
+// connection is closed when the reader and all the pending parameter sets have released it
+class ServerConnection {
+private:
+	FILE* input;
+	const int output_fd;
+	const bool owns_fds;
+	std::mutex write_mutex;
+public:
+	// owns_fds is false for stdin and stdout, otherwise input_fd and output_fd are closed by the destructor
+	ServerConnection(int input_fd, int output_fd, bool owns_fds);
+	ServerConnection(const ServerConnection&) = delete;
+	~ServerConnection();
+	// Reads the next line without the trailing newline, returns false at the end of input
+	bool readLine(std::string& line);
+	void writeLine(const std::string& line);
+};
+
+
+// Fixed number of threads calculating submitted tasks in the order of submission
+class WorkerPool {
+private:
+	std::vector<std::thread> threads;
+	std::queue<std::function<void ()>> tasks;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool stopping = false;
+private:
+	void work();
+public:
+	// Zero n_threads means the number of CPU cores
+	explicit WorkerPool(unsigned int n_threads);
+	WorkerPool(const WorkerPool&) = delete;
+	// Waits for all the submitted tasks
+	~WorkerPool();
+	void submit(std::function<void ()>&& task);
+};
+
+
+// Parameter set read by the server from a JSON line like
+// {"id": "run1", "options": {"alpha": 0.3, "passband": ["B.dat", "V.dat"], "fulldata": true}, "times": [1, 2.5], "columns": ["t", "Mdot"]}
+// all keys are optional
+struct ServerRequest {
+	// Identifier to match the result with the request, the number of the line if it is not given
+	std::string id;
+	// Options in the command line form, e.g. "--alpha=0.3", true values turn into flags and false values are skipped
+	std::vector<std::string> args;
+	// Time moments to output, days. Time steps are output as in PREFIX.dat if there are no times
+	vecd times;
+	// Names of PREFIX.dat columns to output, all columns if empty
+	std::vector<std::string> columns;
+
+	static ServerRequest fromJson(const std::string& line, const std::string& default_id);
+};
+
+std::string jsonString(const std::string& s);
+std::string jsonNumber(double x, unsigned short precision);
+std::string jsonError(const std::string& id, const std::string& what);
+// Starts listening on the Unix socket and returns its file descriptor, a stale socket file is replaced
+int listenUnixSocket(const std::string& path);
+
+
+// Calculates the parameter set calling head(fields) once with the PREFIX.dat columns to output, and dump(fields) for
+// every state to output. Returns the reason why the calculation has ended before its time is out or an empty string.
+// Options of the request take precedence over sources, which are the command line and configuration files. Passband
+// files are read by passband_cache if it is given
+template <typename Output, typename Options, typename Evolution, typename Head, typename Dump>
+std::string calculate_request(const ServerRequest& request, const po::options_description& desc,
+							  const std::vector<po::parsed_options>& sources, Head&& head, Dump&& dump,
+							  PassbandCache* passband_cache = nullptr) {
+	po::variables_map vm;
+	po::store(po::command_line_parser(request.args).options(desc).run(), vm);
+	for (const auto& source : sources) {
+		po::store(source, vm);
+	}
+	po::notify(vm);
+	Options opts(vm, passband_cache);
+	std::shared_ptr<Evolution> freddi{new Evolution(opts)};
+
+	const auto all_fields = Output::initializeShortFields(freddi);
+	std::vector<const FileOutputShortField*> fields;
+	if (request.columns.empty()) {
+		for (const auto& field : all_fields) {
+			fields.push_back(&field);
+		}
+	}
+	for (const auto& name : request.columns) {
+		const auto it = std::find_if(all_fields.begin(), all_fields.end(),
+				[&name](const FileOutputShortField& field) { return field.name == name; });
+		if (it == all_fields.end()) {
+			throw std::invalid_argument("Unknown column " + name);
+		}
+		fields.push_back(&*it);
+	}
+
+	vecd output_times(request.times.size());
+	std::transform(request.times.begin(), request.times.end(), output_times.begin(), [](double t) { return dayToS(t); });
+	std::sort(output_times.begin(), output_times.end());
+	if (!output_times.empty() && output_times.front() < freddi->args().calc->init_time) {
+		throw std::invalid_argument("times should not be earlier than --inittime");
+	}
+	if (output_times.empty()) {
+		output_times = freddi->args().general->output_times;
+	}
+
+	head(fields);
+	std::string stop;
+	run_evolution(*freddi, output_times, [&]() { dump(fields); },
+				  [&stop](const char*, size_t, const char* reason) { stop = reason; });
+	return stop;
+}
+
+// Calculates the parameter set and returns its result as a JSON line
+// {"id": "run1", "columns": ["t", "Mdot"], "data": [[1, 1.2e18], [2.5, 9.8e17]], "stop": "Mdot_in < stop_Mdot"}
+// where "stop" is given only if the calculation has ended before its time is out
+template <typename Output, typename Options, typename Evolution>
+std::string serve_request(const ServerRequest& request, const po::options_description& desc,
+						  const std::vector<po::parsed_options>& sources, const unsigned short precision,
+						  PassbandCache* passband_cache = nullptr) {
+	using Fields = std::vector<const FileOutputShortField*>;
+	std::ostringstream result;
+	bool first_row = true;
+	const auto head = [&](const Fields& fields) {
+		result << "{\"id\": " << jsonString(request.id) << ", \"columns\": [";
+		for (size_t i = 0; i < fields.size(); ++i) {
+			result << (i > 0 ? ", " : "") << jsonString(fields[i]->name);
+		}
+		result << "], \"data\": [";
+	};
+	const auto dump = [&](const Fields& fields) {
+		result << (first_row ? "[" : ", [");
+		for (size_t i = 0; i < fields.size(); ++i) {
+			result << (i > 0 ? ", " : "") << jsonNumber(fields[i]->func(), precision);
+		}
+		result << "]";
+		first_row = false;
+	};
+	const std::string stop = calculate_request<Output, Options, Evolution>(request, desc, sources, head, dump,
+																		   passband_cache);
+	result << "]";
+	if (!stop.empty()) {
+		result << ", \"stop\": " << jsonString(stop);
+	}
+	result << "}";
+	return result.str();
+}
+
+// Reads parameter sets from the connection until its end and calculates them by the pool. Results are written in the
+// order of completion, errors are written as {"id": "run1", "error": "..."}
+template <typename Output, typename Options, typename Evolution>
+void serve_connection(const std::shared_ptr<ServerConnection>& connection, WorkerPool& pool,
+					  const po::options_description& desc, const std::vector<po::parsed_options>& sources,
+					  const unsigned short precision, PassbandCache* passband_cache = nullptr) {
+	std::string line;
+	for (size_t i_line = 1; connection->readLine(line); ++i_line) {
+		if (line.find_first_not_of(" \t\r") == std::string::npos) {
+			continue;
+		}
+		const std::string default_id = std::to_string(i_line);
+		pool.submit([connection, line, default_id, &desc, &sources, precision, passband_cache]() {
+			std::string id = default_id;
+			try {
+				const auto request = ServerRequest::fromJson(line, default_id);
+				id = request.id;
+				connection->writeLine(serve_request<Output, Options, Evolution>(request, desc, sources, precision,
+																				passband_cache));
+			} catch (const std::exception& e) {
+				connection->writeLine(jsonError(id, e.what()));
+			}
+		});
+	}
+}
+
+// Server mode of the application: options of the command line and configuration files are parsed once and used as
+// defaults for every parameter set. Parameter sets are read from stdin or from clients of the Unix socket
+template <typename Output, typename Options, typename Evolution>
+bool run_server(const po::variables_map& vm, const po::options_description& desc,
+				const std::vector<po::parsed_options>& sources) {
+	const unsigned short precision = vm["precision"].as<unsigned int>();
+	// results of a disconnected client are dropped
+	std::signal(SIGPIPE, SIG_IGN);
+	// passband files are read once for all parameter sets, the cache outlives the tasks of the pool
+	PassbandCache passband_cache;
+	WorkerPool pool(vm["threads"].as<unsigned int>());
+	if (vm.count("socket") == 0) {
+		serve_connection<Output, Options, Evolution>(std::make_shared<ServerConnection>(0, 1, false), pool, desc,
+													 sources, precision, &passband_cache);
+		return true;
+	}
+	int listen_fd;
+	try {
+		listen_fd = listenUnixSocket(vm["socket"].as<std::string>());
+	} catch (const std::runtime_error& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return false;
+	}
+	for (;;) {
+		const int fd = accept(listen_fd, nullptr, nullptr);
+		if (fd < 0) {
+			if (errno != EINTR && errno != ECONNABORTED) {
+				std::cerr << "Error: " << std::strerror(errno) << std::endl;
+				// e.g. the limit of open files is reached, wait for running clients
+				std::this_thread::sleep_for(std::chrono::seconds(1));
+			}
+			continue;
+		}
+		std::thread(serve_connection<Output, Options, Evolution>, std::make_shared<ServerConnection>(fd, fd, true),
+					std::ref(pool), std::cref(desc), std::cref(sources), precision, &passband_cache).detach();
+	}
+}
+
+#endif //FREDDI_SERVER_HPP
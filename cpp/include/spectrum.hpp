@@ -19,8 +19,35 @@ constexpr const double ch_over_kB = GSL_CONST_CGSM_SPEED_OF_LIGHT * h_over_kB;
 double Planck_nu(double T, double nu);
 double Planck_lambda(double T, double lambda);
 
+// Integral \int 2\pi r B_\lambda(T(r)) dr over [r[first], r[last]] by trapezoid rule for every wavelength of lambdas.
+// Result is written into I, all wavelengths are computed in a single pass over radius
+void disk_radial_Planck_lambda(const vecd& r, const vecd& T, size_t first, size_t last, const vecd& lambdas, vecd& I);
+
 double Planck_nu1_nu2(double T, double nu1, double nu2, double tol=std::sqrt(std::numeric_limits<double>::epsilon()));
 
+// Set of frequency bands [nu1, nu2]. Bands are split by all their edges into non-overlapping segments, so integrals
+// over overlapping or adjacent bands share their common parts and every segment is integrated once
+class FrequencyBands {
+private:
+	vecd edges_;
+	// Segment [edges_[k], edges_[k+1]] is a part of at least one band
+	std::vector<bool> needed_;
+	// Band j consists of segments [first_[j], last_[j])
+	std::vector<size_t> first_;
+	std::vector<size_t> last_;
+public:
+	FrequencyBands(const vecd& nu1, const vecd& nu2);
+	inline size_t size() const { return first_.size(); }
+	// \int B_\nu(T) d\nu over every band with frequencies divided by nu_divider, result is written into integrals
+	void Planck_nu1_nu2(double T, vecd& integrals, double tol, double nu_divider = 1.) const;
+};
+
+// Integral \int 2\pi r \int B_\nu(T(r)) d\nu dr over [r[first], r[last]] by trapezoid rule for every band. Result is
+// written into I, all bands are computed in a single pass over radius
+void disk_radial_Planck_nu1_nu2(const vecd& r, const vecd& T, size_t first, size_t last, const FrequencyBands& bands, vecd& I, double tol);
+
+// Viscous flux sigma T_GR^4 divided by Mdot, it depends on radius only
+double Qvis_GR_over_Mdot(double r1, double ak, double Mx);
 double T_GR(double r1, double ak, double Mx, double Mdot);
 } // namespace Spectrum
 
@@ -37,8 +37,21 @@ public:
 	const vald& Tth() const;
 	virtual const vald& Qirr();
 	const vald& Teff();
-	double integrate(std::function<double (size_t)>&& func) const;
-	double integrate(std::function<double (size_t)>&& func, const UnitVec3& direction) const;
+	// func is any callable object returning integrand value for triangle index i
+	template <typename Func> double integrate(const Func& func) const {
+		double sum = 0;
+		for (size_t i = 0; i < triangles_.size(); ++i) {
+			sum += triangles_[i].area() * func(i);
+		}
+		return sum;
+	}
+	template <typename Func> double integrate(const Func& func, const UnitVec3& direction) const {
+		double sum = 0;
+		for (size_t i = 0; i < triangles_.size(); ++i) {
+			sum += triangles_[i].area_cos(direction) * func(i);
+		}
+		return sum;
+	}
 	double luminosity();
 	double luminosity(const UnitVec3& direction); // erg/s
 	// "Luminosity in direction" is luminosity of isotropic spherical source of radius R with luminosity given by
@@ -46,6 +59,9 @@ public:
 	// "luminosity in direction" / (4 \pi d^2)
 	double luminosity(const UnitVec3& direction, double lambda); // erg/s/Hz
 	double luminosity(const UnitVec3& direction, const Passband& passband); // erg/s/Hz
+	// "Luminosities in direction" for every direction, wavelength and passband in a single pass over triangles,
+	// result is indexed as [direction][band], where lambdas go first and passbands follow them
+	std::vector<vecd> luminosities(const std::vector<UnitVec3>& directions, const vecd& lambdas, const std::vector<Passband>& passbands); // erg/s/Hz
 };
 
 
@@ -0,0 +1,111 @@
+#ifndef FREDDI_SWEEP_HPP
+#define FREDDI_SWEEP_HPP
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "server.hpp"
+
+namespace po = boost::program_options;
+
+
+class SweepOptions {
+public:
+	using Grid = std::vector<std::pair<std::string, std::vector<std::string>>>;
+public:
+	// Path of the file with a parameter set per line in the format of the server, see ServerRequest
+	std::string list;
+	// Options and their values to calculate all their combinations, the last option changes first
+	Grid grid;
+	// Columns of PREFIX.dat to output if the parameter set doesn't give them
+	std::vector<std::string> columns;
+	std::string prefix;
+	std::string dir;
+	unsigned short output_precision;
+public:
+	SweepOptions(const po::variables_map& vm);
+	static Grid gridInitializer(const po::variables_map& vm);
+	static std::vector<std::string> columnsInitializer(const po::variables_map& vm);
+	static po::options_description description();
+};
+
+
+// Parameter sets of the sweep in the order of calculation, they are read from the list file or generated from the grid
+// one by one, so the whole sweep is not kept in memory
+class SweepParameterSets {
+private:
+	std::ifstream list;
+	const SweepOptions::Grid grid;
+	size_t grid_size = 0;
+	size_t count = 0;
+public:
+	explicit SweepParameterSets(const SweepOptions& sweep);
+	// Writes the next parameter set in the format of the server into line, returns false if there are no sets left
+	bool next(std::string& line);
+};
+
+
+// First line of the result of sweep_result(), tabs and newlines of id and message are replaced with spaces
+std::string sweepResultHeader(size_t model, const std::string& id, const std::string& status, const std::string& message);
+
+// Result of a parameter set passed from a worker to the master as the text
+// MODEL \t ID \t STATUS \t MESSAGE
+// names, units and descriptions of the columns separated by tabs, the three lines are omitted if STATUS is error
+// rows of values separated by tabs
+// where STATUS is ok, stop if the calculation has ended before its time is out, or error
+template <typename Output, typename Options, typename Evolution>
+std::string sweep_result(const size_t model, const std::string& line, const SweepOptions& sweep,
+						 const po::options_description& desc, const std::vector<po::parsed_options>& sources) {
+	using Fields = std::vector<const FileOutputShortField*>;
+	std::ostringstream result;
+	result.precision(sweep.output_precision);
+	std::string id = std::to_string(model);
+	try {
+		auto request = ServerRequest::fromJson(line, id);
+		id = request.id;
+		if (request.columns.empty()) {
+			request.columns = sweep.columns;
+		}
+		const auto head = [&result](const Fields& fields) {
+			for (const auto member : {&FileOutputShortField::name, &FileOutputShortField::unit, &FileOutputShortField::description}) {
+				for (size_t i = 0; i < fields.size(); ++i) {
+					result << (i > 0 ? "\t" : "") << fields[i]->*member;
+				}
+				result << "\n";
+			}
+		};
+		const auto dump = [&result](const Fields& fields) {
+			for (size_t i = 0; i < fields.size(); ++i) {
+				result << (i > 0 ? "\t" : "") << fields[i]->func();
+			}
+			result << "\n";
+		};
+		const std::string stop = calculate_request<Output, Options, Evolution>(request, desc, sources, head, dump);
+		return sweepResultHeader(model, id, stop.empty() ? "ok" : "stop", stop) + result.str();
+	} catch (const std::exception& e) {
+		return sweepResultHeader(model, id, "error", e.what());
+	}
+}
+
+
+// Gathers results of the sweep into DIR/PREFIX.dat with the number of the parameter set in the first column and
+// PREFIX.dat columns in the others, and DIR/PREFIX_status.dat with the status of every parameter set
+class SweepStore {
+private:
+	std::ofstream output;
+	std::ofstream status;
+	// Names of the columns, they are taken from the first result and should be the same for all results
+	std::string names;
+	size_t failed_ = 0;
+public:
+	SweepStore(const SweepOptions& sweep);
+	void write(const std::string& result);
+	inline size_t failed() const { return failed_; }
+};
+
+#endif //FREDDI_SWEEP_HPP
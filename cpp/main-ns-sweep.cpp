@@ -0,0 +1,12 @@
+#include <mpi_sweep.hpp>
+#include <ns/ns_evolution.hpp>
+#include <ns/ns_output.hpp>
+#include <ns/ns_options.hpp>
+
+
+int main(int ac, char *av[]) {
+	if (! run_sweep<FreddiNeutronStarFileOutput, FreddiNeutronStarOptions, FreddiNeutronStarEvolution>(ac, av)){
+		return 1;
+	}
+	return 0;
+}
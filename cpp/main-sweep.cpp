@@ -0,0 +1,12 @@
+#include <freddi_evolution.hpp>
+#include <mpi_sweep.hpp>
+#include <options.hpp>
+#include <output.hpp>
+
+
+int main(int ac, char *av[]) {
+	if (! run_sweep<FreddiFileOutput, FreddiOptions, FreddiEvolution>(ac, av)){
+		return 1;
+	}
+	return 0;
+}
@@ -126,6 +126,11 @@ struct DictToMapConverter {
 
 
 void register_converters() {
+	// PyArray_Check() of NumpyToVectorConverter uses the NumPy C API table of this translation unit
+	if (_import_array() < 0) {
+		throw_error_already_set();
+	}
+
 	to_python_converter<vecd, VectorToNumpyConverter<double>, false>();
 	NumpyToVectorConverter<double, NPY_DOUBLE>();
 
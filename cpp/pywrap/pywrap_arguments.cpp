@@ -65,7 +65,17 @@ boost::shared_ptr<FluxArguments> make_flux_arguments(
 		double colourfactor,
 		double emin, double emax,
 		double star_albedo,
-		double inclination, double ephemeris_t0, double distance) {
+		double inclination, double ephemeris_t0, double distance,
+		const object& observers, const object& xbands) {
+	std::vector<Observer> observers_vector;
+	stl_input_iterator<object> begin(observers), end;
+	for (auto observer = begin; observer != end; ++observer) {
+		observers_vector.emplace_back(extract<double>((*observer)[0]), extract<double>((*observer)[1]));
+	}
+	std::vector<EnergyBand> xbands_vector;
+	for (stl_input_iterator<object> band(xbands); band != end; ++band) {
+		xbands_vector.emplace_back(extract<double>((*band)[0]), extract<double>((*band)[1]));
+	}
 	return boost::make_shared<FluxArguments>(
 			colourfactor,
 			emin, emax,
@@ -73,18 +83,21 @@ boost::shared_ptr<FluxArguments> make_flux_arguments(
 			inclination, ephemeris_t0, distance,
 			false, false,
 			vecd(),
-			std::vector<Passband>());
+			std::vector<Passband>(),
+			observers_vector,
+			xbands_vector);
 }
 
 boost::shared_ptr<CalculationArguments> make_calculation_arguments(
 		double inittime,
 		double time, const object& tau,
 		unsigned int Nx, const std::string& gridscale, const unsigned short starlod,
-		const object& eps) {
-	if (eps.ptr() == object().ptr()) {
-		return boost::make_shared<CalculationArguments>(inittime, time, objToOpt<double>(tau), Nx, gridscale, starlod);
-	}
-	return boost::make_shared<CalculationArguments>(inittime, time, objToOpt<double>(tau), Nx, gridscale, starlod, extract<double>(eps));
+		const object& eps, const bool front_tracking, const double regrid_tolerance,
+		const std::string& time_scheme, const std::string& space_scheme,
+		double Mdot_quiescent, const object& tau_quiescent, double self_similar_tolerance,
+		double stop_Mdot, double stop_Lx, double stop_Rhot_to_Rout, unsigned int stop_outbursts, double stop_wall_time) {
+	const double eps_ = eps.ptr() == object().ptr() ? CalculationArguments::default_eps : extract<double>(eps);
+	return boost::make_shared<CalculationArguments>(inittime, time, objToOpt<double>(tau), Nx, gridscale, starlod, eps_, front_tracking, regrid_tolerance, time_scheme, space_scheme, Mdot_quiescent, objToOpt<double>(tau_quiescent), self_similar_tolerance, stop_Mdot, stop_Lx, stop_Rhot_to_Rout, stop_outbursts, stop_wall_time);
 }
 
 boost::shared_ptr<FreddiArguments> make_freddi_arguments(
@@ -42,13 +42,18 @@ boost::shared_ptr<FluxArguments> make_flux_arguments(
 			double colourfactor,
 			double emin, double emax,
 			double star_albedo,
-			double inclination, double ephemeris_t0, double distance);
+			double inclination, double ephemeris_t0, double distance,
+			const object& observers = boost::python::list(),
+			const object& xbands = boost::python::list());
 
 boost::shared_ptr<CalculationArguments> make_calculation_arguments(
 		double inittime,
 		double time, const object& tau,
 		unsigned int Nx, const std::string& gridscale, unsigned short starlod,
-		const object& eps);
+		const object& eps, bool front_tracking, double regrid_tolerance,
+		const std::string& time_scheme, const std::string& space_scheme,
+		double Mdot_quiescent, const object& tau_quiescent, double self_similar_tolerance,
+		double stop_Mdot, double stop_Lx, double stop_Rhot_to_Rout, unsigned int stop_outbursts, double stop_wall_time);
 
 boost::shared_ptr<FreddiArguments> make_freddi_arguments(
 		const GeneralArguments& general,
@@ -71,6 +71,8 @@ dict evolution_kwdefaults() {
 	kw["staralbedo"] = FluxArguments::default_star_albedo;
 	kw["inclination"] = FluxArguments::default_inclination;
 	kw["ephemerist0"] = FluxArguments::default_ephemeris_t0;
+	kw["observers"] = list();
+	kw["xbands"] = list();
 
 	kw["inittime"] = CalculationArguments::default_init_time;
 	kw["tau"] = object();
@@ -78,6 +80,18 @@ dict evolution_kwdefaults() {
 	kw["gridscale"] = CalculationArguments::default_gridscale;
 	kw["starlod"] = CalculationArguments::default_starlod;
 	kw["eps"] = object();
+	kw["fronttracking"] = CalculationArguments::default_front_tracking;
+	kw["regridtol"] = CalculationArguments::default_regrid_tolerance;
+	kw["timescheme"] = CalculationArguments::default_time_scheme;
+	kw["spacescheme"] = CalculationArguments::default_space_scheme;
+	kw["Mdotquiescent"] = CalculationArguments::default_Mdot_quiescent;
+	kw["tauquiescent"] = object();
+	kw["selfsimilartol"] = CalculationArguments::default_self_similar_tolerance;
+	kw["stopMdot"] = CalculationArguments::default_stop_Mdot;
+	kw["stopLx"] = CalculationArguments::default_stop_Lx;
+	kw["stopRhot2Rout"] = CalculationArguments::default_stop_Rhot_to_Rout;
+	kw["stopoutbursts"] = CalculationArguments::default_stop_outbursts;
+	kw["stopwalltime"] = CalculationArguments::default_stop_wall_time;
 
 	return kw;
 }
@@ -121,12 +135,26 @@ void update_no_cgs_kwargs(dict& kw) {
 	kw["emin"] = kevToHertz(extract<double>(kw["emin"]));
 	kw["emax"] = kevToHertz(extract<double>(kw["emax"]));
 	kw["distance"] = kpcToCm(extract<double>(kw["distance"]));
+	list observers;
+	stl_input_iterator<object> begin(kw["observers"]), end;
+	for (auto observer = begin; observer != end; ++observer) {
+		observers.append(make_tuple((*observer)[0], kpcToCm(extract<double>((*observer)[1]))));
+	}
+	kw["observers"] = observers;
+	list xbands;
+	for (stl_input_iterator<object> band(kw["xbands"]); band != end; ++band) {
+		xbands.append(make_tuple(kevToHertz(extract<double>((*band)[0])), kevToHertz(extract<double>((*band)[1]))));
+	}
+	kw["xbands"] = xbands;
 
 	kw["inittime"] = dayToS(extract<double>(kw["inittime"]));
 	kw["time"] = dayToS(extract<double>(kw["time"]));
 	if (object(kw["tau"]).ptr() != None) {
 		kw["tau"] = dayToS(extract<double>(kw["tau"]));
 	}
+	if (object(kw["tauquiescent"]).ptr() != None) {
+		kw["tauquiescent"] = dayToS(extract<double>(kw["tauquiescent"]));
+	}
 }
 
 
@@ -161,13 +189,20 @@ boost::shared_ptr<FreddiArguments> make_freddi_arguments(dict& kw) {
 			extract<double>(kw["colourfactor"]),
 			extract<double>(kw["emin"]), extract<double>(kw["emax"]),
 			extract<double>(kw["staralbedo"]),
-			extract<double>(kw["inclination"]), extract<double>(kw["ephemerist0"]), extract<double>(kw["distance"]));
+			extract<double>(kw["inclination"]), extract<double>(kw["ephemerist0"]), extract<double>(kw["distance"]),
+			kw["observers"], kw["xbands"]);
 	const auto calc = make_calculation_arguments(
 			extract<double>(kw["inittime"]),
 			extract<double>(kw["time"]), kw["tau"],
 			extract<unsigned int>(kw["Nx"]), extract<std::string>(kw["gridscale"]),
 			extract<unsigned short>(kw["starlod"]),
-			kw["eps"]);
+			kw["eps"], extract<bool>(kw["fronttracking"]), extract<double>(kw["regridtol"]),
+			extract<std::string>(kw["timescheme"]), extract<std::string>(kw["spacescheme"]),
+			extract<double>(kw["Mdotquiescent"]), kw["tauquiescent"],
+			extract<double>(kw["selfsimilartol"]),
+			extract<double>(kw["stopMdot"]), extract<double>(kw["stopLx"]),
+			extract<double>(kw["stopRhot2Rout"]), extract<unsigned int>(kw["stopoutbursts"]),
+			extract<double>(kw["stopwalltime"]));
 	// To avoid copy, create FreddiArguments constructor that accepts shared_ptr
 	return make_freddi_arguments(*general, *basic, *disk, *irr, *flux, *calc);
 }
@@ -264,13 +299,20 @@ boost::shared_ptr<FreddiNeutronStarArguments> make_freddi_neutron_star_arguments
 			extract<double>(kw["colourfactor"]),
 			extract<double>(kw["emin"]), extract<double>(kw["emax"]),
 			extract<double>(kw["staralbedo"]),
-			extract<double>(kw["inclination"]), extract<double>(kw["ephemerist0"]), extract<double>(kw["distance"]));
+			extract<double>(kw["inclination"]), extract<double>(kw["ephemerist0"]), extract<double>(kw["distance"]),
+			kw["observers"], kw["xbands"]);
 	const auto calc = make_calculation_arguments(
 			extract<double>(kw["inittime"]),
 			extract<double>(kw["time"]), kw["tau"],
 			extract<unsigned int>(kw["Nx"]), extract<std::string>(kw["gridscale"]),
 			extract<unsigned short>(kw["starlod"]),
-			kw["eps"]);
+			kw["eps"], extract<bool>(kw["fronttracking"]), extract<double>(kw["regridtol"]),
+			extract<std::string>(kw["timescheme"]), extract<std::string>(kw["spacescheme"]),
+			extract<double>(kw["Mdotquiescent"]), kw["tauquiescent"],
+			extract<double>(kw["selfsimilartol"]),
+			extract<double>(kw["stopMdot"]), extract<double>(kw["stopLx"]),
+			extract<double>(kw["stopRhot2Rout"]), extract<unsigned int>(kw["stopoutbursts"]),
+			extract<double>(kw["stopwalltime"]));
 	return make_freddi_neutron_star_arguments(*general, *basic, *disk, *irr, *flux, *calc, *ns_args);
 }
 
@@ -292,6 +334,16 @@ object raw_make_neutron_star_evolution(const tuple& args, const dict& kwargs) {
 }
 
 
+// Copy of the state at the time moment t, None if it cannot be reached, see FreddiEvolution::evolve_to
+template <typename T>
+object evolve_to(T& freddi, const double t) {
+	if (!freddi.evolve_to(t)) {
+		return object();
+	}
+	return object(freddi);
+}
+
+
 double (FreddiNeutronStarEvolution::*fp_getter)() const = &FreddiNeutronStarEvolution::fp;
 double (FreddiNeutronStarEvolution::*eta_ns_getter)() const = &FreddiNeutronStarEvolution::eta_ns;
 
@@ -301,6 +353,7 @@ void wrap_evolution() {
 		.def("__init__", raw_function(&raw_make_evolution))
 		.def(init<const FreddiArguments&>())
 		.def("__iter__", iterator<FreddiEvolution>())
+		.def("_evolve_to", &evolve_to<FreddiEvolution>)
 		.def("_required_args", evolution_required_args, "Mock values for non-scientific calls")
 		.staticmethod("_required_args")
 	;
@@ -308,6 +361,7 @@ void wrap_evolution() {
 		.def("__init__", raw_function(&raw_make_neutron_star_evolution))
 		.def(init<const FreddiNeutronStarArguments&>())
 		.def("__iter__", iterator<FreddiNeutronStarEvolution>())
+		.def("_evolve_to", &evolve_to<FreddiNeutronStarEvolution>)
 		.def("_required_args", neutron_star_evolution_required_args, "Mock values for non-scientific calls")
 		.staticmethod("_required_args")
 		.add_property("mu_magn", &FreddiNeutronStarEvolution::mu_magn)
@@ -322,5 +376,6 @@ void wrap_evolution() {
 		.add_property("T_hot_spot", &FreddiNeutronStarEvolution::T_hot_spot)
 		.add_property("Lbol_ns", &FreddiNeutronStarEvolution::Lbol_ns)
 		.add_property("Lx_ns", &FreddiNeutronStarEvolution::Lx_ns)
+		.add_property("Lx_ns_bands", &FreddiNeutronStarEvolution::Lx_ns_bands)
 	;
 }
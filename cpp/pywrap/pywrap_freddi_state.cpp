@@ -10,10 +10,27 @@
 using namespace boost::python;
 
 
+template<FreddiState::DiskIntegrationRegion Region>
+vecd spectrum_observer(FreddiState& state, const vecd& lambdas, const size_t i_obs) {
+	return state.spectrum_region<Region>(lambdas, state.observers().at(i_obs));
+}
+
+vecd spectrum_star_observer(FreddiState& state, const vecd& lambdas, const double phase, const size_t i_obs) {
+	return state.spectrum_star(lambdas, phase, state.observers().at(i_obs));
+}
+
+size_t observers_number(const FreddiState& state) {
+	return state.observers().size();
+}
+
+
 void wrap_state() {
 	double (FreddiState::*flux_hot)(double) = &FreddiState::flux;
 	double (FreddiState::*flux_cold)(double) = &FreddiState::flux_region<FreddiState::ColdRegion>;
 	double (FreddiState::*flux_star)(double, double) = &FreddiState::flux_star;
+	vecd (FreddiState::*spectrum_hot)(const vecd&) = &FreddiState::spectrum;
+	vecd (FreddiState::*spectrum_cold)(const vecd&) = &FreddiState::spectrum_region<FreddiState::ColdRegion>;
+	vecd (FreddiState::*spectrum_star)(const vecd&, double) = &FreddiState::spectrum_star;
 
 	class_<FreddiState>("_State", no_init)
 	    .add_property("GM", &FreddiState::GM)
@@ -23,12 +40,14 @@ void wrap_state() {
 		.add_property("Mdot", &FreddiState::Mdot_in)
 		.add_property("Mdot_out", &FreddiState::Mdot_out)
 		.add_property("Lx", &FreddiState::Lx)
+		.add_property("Lx_bands", make_function(&FreddiState::Lx_bands, return_value_policy<copy_const_reference>()))
 		.add_property("t", &FreddiState::t)
 		.add_property("i_t", &FreddiState::i_t)
 		.add_property("Nt", &FreddiState::Nt)
 		.add_property("Nx", &FreddiState::Nx)
 		.add_property("first", &FreddiState::first)
 		.add_property("last", &FreddiState::last)
+		.add_property("R_hot", &FreddiState::R_hot)
 		.add_property("Mdisk", &FreddiState::Mdisk)
 		.add_property("Mdot_wind", &FreddiState::Mdot_wind)
 		.add_property("h", make_function(&FreddiState::h, return_value_policy<copy_const_reference>()))
@@ -48,5 +67,12 @@ void wrap_state() {
 		.def("_flux_hot", flux_hot)
 		.def("_flux_cold", flux_cold)
 		.def("_flux_star", flux_star)
+		.def("_spectrum_hot", spectrum_hot)
+		.def("_spectrum_cold", spectrum_cold)
+		.def("_spectrum_star", spectrum_star)
+		.add_property("_observers_number", &observers_number)
+		.def("_spectrum_hot_observer", &spectrum_observer<FreddiState::HotRegion>)
+		.def("_spectrum_cold_observer", &spectrum_observer<FreddiState::ColdRegion>)
+		.def("_spectrum_star_observer", &spectrum_star_observer)
 	;
 }
@@ -348,4 +348,14 @@ constexpr const double CalculationArguments::default_init_time;
 constexpr const unsigned int CalculationArguments::default_Nx;
 constexpr const unsigned int CalculationArguments::default_Nt_for_tau;
 constexpr const char CalculationArguments::default_gridscale[];
+constexpr const char CalculationArguments::default_time_scheme[];
+constexpr const char CalculationArguments::default_space_scheme[];
+constexpr const double CalculationArguments::default_Mdot_quiescent;
+constexpr const unsigned int CalculationArguments::default_quiescent_step_factor;
+constexpr const double CalculationArguments::default_self_similar_tolerance;
+constexpr const double CalculationArguments::default_stop_Mdot;
+constexpr const double CalculationArguments::default_stop_Lx;
+constexpr const double CalculationArguments::default_stop_Rhot_to_Rout;
+constexpr const unsigned int CalculationArguments::default_stop_outbursts;
+constexpr const double CalculationArguments::default_stop_wall_time;
 constexpr const unsigned short CalculationArguments::default_starlod;
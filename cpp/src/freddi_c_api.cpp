@@ -0,0 +1,225 @@
+#include "freddi_c_api.h"
+
+#include <algorithm>  // fill max min
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "freddi_evolution.hpp"
+#include "options.hpp"
+#include "output.hpp"
+#include "ns/ns_evolution.hpp"
+#include "ns/ns_options.hpp"
+#include "ns/ns_output.hpp"
+
+namespace po = boost::program_options;
+
+
+struct freddi_model {
+	std::shared_ptr<FreddiEvolution> evolution;
+	// Fields of the output files, they are bound to evolution
+	std::vector<FileOutputShortField> scalars;
+	std::vector<FileOutputLongField> fields;
+	std::unordered_map<std::string, size_t> scalar_indices;
+	std::unordered_map<std::string, size_t> field_indices;
+};
+
+
+namespace {
+thread_local std::string last_error;
+
+// Calls func and converts exceptions into the error code, the message is kept for freddi_last_error(). No exception
+// may cross the C interface, so exceptions of other types are caught too
+template <typename Func> auto guarded(Func&& func, decltype(func()) error_value) -> decltype(func()) {
+	try {
+		return func();
+	} catch (const std::exception& e) {
+		last_error = e.what();
+	} catch (...) {
+		last_error = "Unknown exception";
+	}
+	return error_value;
+}
+
+template <typename Field> std::unordered_map<std::string, size_t> field_indices(const std::vector<Field>& fields) {
+	std::unordered_map<std::string, size_t> indices;
+	for (size_t i = 0; i < fields.size(); ++i) {
+		indices.emplace(fields[i].name, i);
+	}
+	return indices;
+}
+
+template <typename Output, typename Options, typename Evolution>
+freddi_model* create(const int argc, const char* const* argv) {
+	po::variables_map vm;
+	po::store(po::command_line_parser(std::vector<std::string>(argv, argv + argc)).options(Options::description()).run(), vm);
+	po::notify(vm);
+	Options opts(vm);
+	std::shared_ptr<Evolution> evolution{new Evolution(opts)};
+	std::unique_ptr<freddi_model> model{new freddi_model};
+	model->evolution = evolution;
+	model->scalars = Output::initializeShortFields(evolution);
+	model->fields = Output::initializeDiskStructureFields(evolution);
+	model->scalar_indices = field_indices(model->scalars);
+	model->field_indices = field_indices(model->fields);
+	return model.release();
+}
+
+size_t find_index(const std::unordered_map<std::string, size_t>& indices, const char* name, const char* kind) {
+	const auto it = indices.find(name);
+	if (it == indices.end()) {
+		throw std::invalid_argument(std::string("Unknown ") + kind + " " + name);
+	}
+	return it->second;
+}
+} // namespace
+
+
+extern "C" {
+
+freddi_model* freddi_create(const int argc, const char* const* argv, const int neutron_star) {
+	return guarded([=]() {
+		if (neutron_star) {
+			return create<FreddiNeutronStarFileOutput, FreddiNeutronStarOptions, FreddiNeutronStarEvolution>(argc, argv);
+		}
+		return create<FreddiFileOutput, FreddiOptions, FreddiEvolution>(argc, argv);
+	}, nullptr);
+}
+
+void freddi_destroy(freddi_model* model) {
+	delete model;
+}
+
+const char* freddi_last_error(void) {
+	return last_error.c_str();
+}
+
+int freddi_step(freddi_model* model) {
+	return guarded([model]() {
+		auto& evolution = *model->evolution;
+		if (evolution.i_t() >= evolution.Nt() || evolution.stop_reason() != nullptr) {
+			return 0;
+		}
+		const auto& calc = *evolution.args().calc;
+		// after freddi_evolve_to() to a moment between time steps the last step is shortened to the end of the calculation
+		const double remainder = calc.init_time + calc.time - evolution.t();
+		if (remainder < (1. - 1e-6) * calc.tau) {
+			evolution.step(remainder);
+		} else {
+			evolution.step();
+		}
+		return 1;
+	}, -1);
+}
+
+int freddi_evolve_to(freddi_model* model, const double t) {
+	return guarded([model, t]() {
+		return model->evolution->evolve_to(t) ? 1 : 0;
+	}, -1);
+}
+
+double freddi_time(const freddi_model* model) {
+	return model->evolution->t();
+}
+
+size_t freddi_i_t(const freddi_model* model) {
+	return model->evolution->i_t();
+}
+
+size_t freddi_Nx(const freddi_model* model) {
+	return model->evolution->Nx();
+}
+
+size_t freddi_first(const freddi_model* model) {
+	return model->evolution->first();
+}
+
+size_t freddi_last(const freddi_model* model) {
+	return model->evolution->last();
+}
+
+size_t freddi_scalar_count(const freddi_model* model) {
+	return model->scalars.size();
+}
+
+const char* freddi_scalar_name(const freddi_model* model, const size_t index) {
+	if (index >= model->scalars.size()) {
+		return nullptr;
+	}
+	return model->scalars[index].name.c_str();
+}
+
+int freddi_scalars(freddi_model* model, const size_t n, const char* const* names, double* values) {
+	return guarded([=]() {
+		for (size_t i = 0; i < n; ++i) {
+			values[i] = model->scalars[find_index(model->scalar_indices, names[i], "scalar")].func();
+		}
+		return 0;
+	}, -1);
+}
+
+int freddi_field(freddi_model* model, const char* name, double* buffer, const size_t size) {
+	return guarded([=]() {
+		const auto& func = model->fields[find_index(model->field_indices, name, "field")].func;
+		const size_t Nx = model->evolution->Nx();
+		if (size < Nx) {
+			throw std::invalid_argument("Buffer is smaller than Nx");
+		}
+		for (size_t i = 0; i < Nx; ++i) {
+			buffer[i] = func(i);
+		}
+		return 0;
+	}, -1);
+}
+
+int freddi_run_batch(const int neutron_star, const size_t n_models, const int* argcs, const char* const* const* argvs,
+		const size_t n_times, const double* times, const size_t n_names, const char* const* names,
+		double* values, int* status, unsigned int n_threads) {
+	std::fill(values, values + n_models * n_times * n_names, std::numeric_limits<double>::quiet_NaN());
+	std::atomic<size_t> next_model(0);
+	std::atomic<int> failed(0);
+	// Run times differ a lot, so every thread takes the next model when it has finished the previous one
+	const auto worker = [&]() {
+		for (size_t i = next_model++; i < n_models; i = next_model++) {
+			status[i] = 0;
+			freddi_model* model = freddi_create(argcs[i], argvs[i], neutron_star);
+			if (model == nullptr) {
+				status[i] = -1;
+			}
+			for (size_t j = 0; model != nullptr && j < n_times; ++j) {
+				const int reached = freddi_evolve_to(model, times[j]);
+				if (reached < 0 || (reached > 0 && freddi_scalars(model, n_names, names, values + (i * n_times + j) * n_names) < 0)) {
+					status[i] = -1;
+				}
+				if (reached <= 0 || status[i] < 0) {
+					break;
+				}
+			}
+			freddi_destroy(model);
+			if (status[i] < 0) {
+				++failed;
+			}
+		}
+	};
+	if (n_threads == 0) {
+		n_threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	n_threads = static_cast<unsigned int>(std::min<size_t>(n_threads, std::max<size_t>(n_models, 1)));
+	std::vector<std::thread> threads;
+	for (unsigned int i = 1; i < n_threads; ++i) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	return failed;
+}
+
+} // extern "C"
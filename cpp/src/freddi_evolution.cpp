@@ -1,5 +1,6 @@
 #include "freddi_evolution.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 
@@ -7,29 +8,229 @@
 #include "exceptions.hpp"
 #include "nonlinear_diffusion.hpp"
 
-using namespace std::placeholders;
-
 
 FreddiEvolution::FreddiEvolution(const FreddiArguments &args):
-		FreddiState(args, std::bind(&FreddiEvolution::wunction, this, _1, _2, _3, _4)) {}
+		// W() calls the overridden wunction(), so no wunc is bound to this
+		FreddiState(args, wunc_t()),
+		start_time_(std::chrono::steady_clock::now()),
+		solver_(initialize_solver(*args.calc, compact_space_scheme())) {}
+
+
+FreddiEvolution::solver_t FreddiEvolution::initialize_solver(const CalculationArguments& calc, const bool compact) {
+	if (calc.time_scheme == "trbdf2") {
+		return compact ? &nonlinear_diffusion_nonuniform_wind_2_4<OpacityWProvider> : &nonlinear_diffusion_nonuniform_wind_2_2<OpacityWProvider>;
+	}
+	if (calc.time_scheme == "euler") {
+		return compact ? &nonlinear_diffusion_nonuniform_wind_1_4<OpacityWProvider> : &nonlinear_diffusion_nonuniform_wind_1_2<OpacityWProvider>;
+	}
+	throw std::invalid_argument("Wrong time_scheme");
+}
 
 
 void FreddiEvolution::step(const double tau) {
 	truncateInnerRadius();
 	FreddiState::step(tau);
-	nonlinear_diffusion_nonuniform_wind_1_2(
-			args().calc->tau, args().calc->eps,
+	if (self_similar_time_ > 0.) {
+		const double factor = std::pow(1. + tau / self_similar_time_, -1. / oprel().m);
+		for (size_t i = first(); i <= last(); ++i) {
+			current_.F[i] *= factor;
+		}
+		self_similar_time_ += tau;
+		count_outbursts();
+		invalidate_star_sources();
+		return;
+	}
+	const bool check_self_similar = args().calc->self_similar_tolerance > 0. && self_similar_decay_possible();
+	if (check_self_similar) {
+		F_old_.assign(F().begin(), F().begin() + last() + 1);
+	}
+	const bool front_node = has_front_node();
+	if (front_node) {
+		front_h_.assign(h().begin(), h().begin() + last() + 2);
+		front_h_[last() + 1] = h_hot();
+	}
+	const auto& x = front_node ? front_h_ : h();
+	const size_t solver_last = front_node ? last() + 1 : last();
+	const auto& calc = *args().calc;
+	solver_(
+			tau, calc.eps,
 			F_in(), Mdot_out(),
 			windA(), windB(), windC(),
-			wunc(),
-			h(), current_.F,
-			first(), last());
-	truncateOuterRadius();
-	star_.set_sources(star_irr_sources());
+			w_provider(),
+			x, current_.F,
+			first(), solver_last);
+	if (check_self_similar) {
+		check_self_similarity(F_old_, tau);
+	}
+	const double h_hot_old = h_hot();
+	truncateOuterRadius(tau);
+	h_hot_velocity_ = (h_hot() - h_hot_old) / tau;
+	refineGrid();
+	count_outbursts();
+	invalidate_star_sources();
+}
+
+
+void FreddiEvolution::count_outbursts() {
+	if (args().calc->stop_outbursts == 0 || !std::isfinite(Mdot_in_prev())) {
+		return;
+	}
+	const double Mdot = Mdot_in();
+	if (Mdot > Mdot_in_prev()) {
+		Mdot_in_rises_ = true;
+	} else if (Mdot < Mdot_in_prev() && Mdot_in_rises_) {
+		Mdot_in_rises_ = false;
+		++outbursts_;
+	}
+}
+
+
+bool FreddiEvolution::evolve_to(const double t_target) {
+	const auto& calc = *args().calc;
+	if (t_target > calc.init_time + calc.time) {
+		return false;
+	}
+	// a remainder shorter than this is added to the last step
+	const double t_tolerance = 1e-6 * calc.tau;
+	while (t_target - t() > t_tolerance) {
+		if (stop_reason() != nullptr) {
+			return false;
+		}
+		// The self-similar solution is exact for a step of any length, so it jumps to t_target in one O(Nx) step
+		// unless the decay can meet a stop condition in between
+		if (self_similar_time_ > 0. && calc.stop_Mdot == 0. && calc.stop_Lx == 0.) {
+			step(t_target - t());
+			break;
+		}
+		const double tau = quiescent_step_factor() * calc.tau;
+		step(t_target - t() < tau + t_tolerance ? t_target - t() : tau);
+	}
+	return true;
+}
+
+
+const char* FreddiEvolution::stop_reason() {
+	const auto& calc = *args().calc;
+	const bool decays = Mdot_in() < Mdot_in_prev();
+	if (decays && calc.stop_Mdot > 0. && Mdot_in() < calc.stop_Mdot) {
+		return "Mdot_in < stop_Mdot";
+	}
+	if (decays && calc.stop_Lx > 0. && Lx() < calc.stop_Lx) {
+		return "Lx < stop_Lx";
+	}
+	if (R_hot() < calc.stop_Rhot_to_Rout * args().basic->rout) {
+		return "R_hot < stop_Rhot_to_Rout * rout";
+	}
+	if (calc.stop_outbursts > 0 && outbursts_ >= calc.stop_outbursts) {
+		return "outbursts >= stop_outbursts";
+	}
+	if (calc.stop_wall_time > 0.
+			&& std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count() > calc.stop_wall_time) {
+		return "wall time > stop_wall_time";
+	}
+	return nullptr;
+}
+
+
+size_t FreddiEvolution::quiescent_step_factor() {
+	const auto& calc = *args().calc;
+	const size_t factor = static_cast<size_t>(std::round(calc.tau_quiescent / calc.tau));
+	if (calc.Mdot_quiescent <= 0. || factor <= 1 || !(Mdot_in() < calc.Mdot_quiescent) || i_t() >= Nt()) {
+		return 1;
+	}
+	// Rising accretion rate means the onset of an outburst
+	if (!(Mdot_in() <= Mdot_in_prev())) {
+		return 1;
+	}
+	// The larger step shouldn't step over the end of the calculation, t() can be between time steps after evolve_to()
+	const size_t k = std::min(factor, static_cast<size_t>(std::floor((calc.init_time + calc.time - t()) / calc.tau + 1e-6)));
+	if (k <= 1) {
+		return 1;
+	}
+	// The hot disk boundary moving with the cooling front shouldn't cross more than one grid cell during the step
+	if (last() + 1 < Nx() && std::abs(h_hot_velocity_) * k * calc.tau > h()[last() + 1] - h()[last()]) {
+		return 1;
+	}
+	return k;
 }
 
 
-void FreddiEvolution::truncateOuterRadius() {
+bool FreddiEvolution::self_similar_decay_possible() const {
+	const auto& disk = *args().disk;
+	return disk.Thot <= 0. && disk.wind == "no" && disk.Mdotout == 0. && F_in() == 0.;
+}
+
+
+void FreddiEvolution::check_self_similarity(const vecd& F_old, const double tau) {
+	// F[first()] is fixed by the boundary condition
+	double q_min = INFINITY;
+	double q_max = 0.;
+	for (size_t i = first() + 1; i <= last(); ++i) {
+		const double q = F()[i] / F_old[i];
+		q_min = std::min(q_min, q);
+		q_max = std::max(q_max, q);
+	}
+	if (!(q_max < 1.) || q_max - q_min > args().calc->self_similar_tolerance * (1. - q_max)) {
+		return;
+	}
+	// The step has decreased F by q = (1 + tau / t_s)^(-1/m), where t_s is counted at its start
+	const double q_m = std::pow(0.5 * (q_min + q_max), -oprel().m);
+	self_similar_time_ = tau * q_m / (q_m - 1.);
+}
+
+
+template <typename Coldness>
+void FreddiEvolution::truncateOuterRadius(const Coldness& coldness) {
+	const size_t ii = search_hot_edge([&coldness](const size_t i) { return coldness(i) > 0.; });
+	const size_t old_last = last();
+
+	if (!args().calc->front_tracking) {
+		if ( ii <= old_last - 1 ){
+			current_.last = ii;
+			current_.h_hot = h()[ii];
+			truncate_optional_structure(old_last);
+		}
+		return;
+	}
+
+	// Find the zero of linearly interpolated coldness between the hot node ii and the next point
+	double h_front, F_front;
+	if (ii < old_last) {
+		const double g_hot = coldness(ii);
+		const double g_cold = coldness(ii + 1);
+		const double fraction = -g_hot / (g_cold - g_hot);
+		h_front = h()[ii] + fraction * (h()[ii + 1] - h()[ii]);
+		F_front = F()[ii] + fraction * (F()[ii + 1] - F()[ii]);
+	} else {
+		// all grid nodes are hot, extrapolate coldness outwards
+		const double g_inner = coldness(ii - 1);
+		const double g_outer = coldness(ii);
+		if (g_outer <= g_inner) {
+			return;
+		}
+		h_front = h()[ii] - g_outer / (g_outer - g_inner) * (h()[ii] - h()[ii - 1]);
+		if (h_front >= h_hot()) {
+			return;
+		}
+		// F()[ii + 1] is the value at h_hot()
+		F_front = F()[ii] + (h_front - h()[ii]) / (h_hot() - h()[ii]) * (F()[ii + 1] - F()[ii]);
+	}
+
+	// The boundary node should be at least a half of a cell farther than the last grid node
+	const size_t new_last = (h_front - h()[ii] < 0.5 * (h()[ii + 1] - h()[ii])) ? ii - 1 : ii;
+	if (new_last <= first()) {
+		throw RadiusCollapseException();
+	}
+	current_.last = new_last;
+	current_.h_hot = h_front;
+	current_.F[new_last + 1] = F_front;
+	if (new_last < old_last) {
+		truncate_optional_structure(old_last);
+	}
+}
+
+
+void FreddiEvolution::truncateOuterRadius(const double tau) {
 	if (args().disk->Thot <= 0. ){
 		return;
 	}
@@ -42,42 +243,78 @@ void FreddiEvolution::truncateOuterRadius() {
 		return;
 	}
 
-	auto ii = last() + 1;
 	if (Tirr().at(last()) / Tph_vis().at(last()) < args().disk->Tirr2Tvishot) {
 	// when irradiation is not important
 	// hot disc extends as far as Sigma>Sigma_max_cold(alpha_cold) and not farther than R_cooling_front and Tirr <= Thot 
-		do {
-			ii--;
-			if (ii <= first()) throw RadiusCollapseException();
-		  } while( ( R().at(ii) > R_cooling_front ( R().at(ii)) ) && ( Sigma().at(ii) < Sigma_minus(R().at(ii)) ) && ( Tirr().at(ii) < args().disk->Thot ) );
-		//} while( ( R().at(ii) > R_cooling_front ( R().at(ii)) ) && ( Sigma().at(ii) < Sigma_minus(R().at(ii)) ) );
+		const vecd& RR = R();
+		const vecd& SS = Sigma();
+		const vecd& TT = Tirr();
+		const vecd& SS_minus = Sigma_minus();
+		const double R_out = R_hot();
+		const double log_Sigma_out = std::log(SS[last()]);
+		const double Thot = args().disk->Thot;
+		truncateOuterRadius([&](const size_t i) {
+			return std::min({
+				1. - (R_out - v_cooling_front(i, log_Sigma_out) * tau) / RR[i],
+				1. - SS[i] / SS_minus[i],
+				1. - TT[i] / Thot});
+		});
 	} else if (args().disk->boundcond == "Teff") {
 	// irradiation is important, the boundary is at fixed Teff
-		do {
-			ii--;
-			if (ii <= first()) throw RadiusCollapseException();
-		} while( Tph().at(ii) < args().disk->Thot );
+		const vecd& TT = Tph();
+		const double Thot = args().disk->Thot;
+		truncateOuterRadius([&TT, Thot](const size_t i) { return 1. - TT[i] / Thot; });
 	} else if (args().disk->boundcond == "Tirr") {
 	// irradiation is important, the boundary is at fixed Tir
-		do {
-			ii--;
-			if (ii <= first()) throw RadiusCollapseException();
-		} while( Tirr().at(ii) < args().disk->Thot );
+		const vecd& TT = Tirr();
+		const double Thot = args().disk->Thot;
+		truncateOuterRadius([&TT, Thot](const size_t i) { return 1. - TT[i] / Thot; });
 	} else{
 		throw std::invalid_argument("Wrong boundcond");
 	}
+}
+
+
+void FreddiEvolution::refineGrid() {
+	const double tolerance = args().calc->regrid_tolerance;
+	if (tolerance <= 0.) {
+		return;
+	}
+	// Fraction of the grid intervals which are placed into the hot disk by the refinement
+	constexpr double hot_fraction = 0.9;
+	const size_t n_hot = static_cast<size_t>(hot_fraction * (Nx() - 1 - first()));
+	if (static_cast<double>(last() - first()) >= (1. - tolerance) * n_hot) {
+		return;
+	}
 
-	if ( ii <= last() - 1 ){
-		current_.last = ii;
-		invalidate_optional_structure();
+	// Nodes are uniform in the coordinate of --gridscale except the hot disk, where intervals near its edges
+	// are (1 - clustering) / (1 + clustering) times the intervals in its middle
+	constexpr double clustering = 0.75;
+	const bool log_scale = args().calc->gridscale == "log";
+	const auto coord = [log_scale](const double x) { return log_scale ? std::log(x) : x; };
+	const auto inverse_coord = [log_scale](const double s) { return log_scale ? std::exp(s) : s; };
+	const double s_in = coord(h()[first()]);
+	const double s_hot = coord(h_hot());
+	const double s_out = coord(h()[Nx() - 1]);
+	const size_t new_last = first() + n_hot;
+	vecd new_h(h().begin(), h().begin() + first() + 1);
+	new_h.resize(Nx());
+	for (size_t i = first() + 1; i < new_last; ++i) {
+		const double xi = static_cast<double>(i - first()) / n_hot;
+		const double t = xi - clustering * std::sin(2. * M_PI * xi) / (2. * M_PI);
+		new_h[i] = inverse_coord(s_in + t * (s_hot - s_in));
 	}
+	new_h[new_last] = h_hot();
+	for (size_t i = new_last + 1; i < Nx() - 1; ++i) {
+		new_h[i] = inverse_coord(s_hot + (s_out - s_hot) * (i - new_last) / (Nx() - 1 - new_last));
+	}
+	new_h[Nx() - 1] = h()[Nx() - 1];
+	replace_grid(std::move(new_h), new_last);
 }
 
 
 vecd FreddiEvolution::wunction(const vecd &h, const vecd &F, size_t _first, size_t _last) const {
 	vecd W(_last + 1, 0.);
-	for ( size_t i = _first; i <= _last; ++i ){
-		W[i] = pow(std::abs(F[i]), 1. - oprel().m) * pow(h[i], oprel().n) / (1. - oprel().m) / oprel().D;
-	}
+	nonlinear_diffusion_w(w_provider(), h, F, _first, _last, W);
 	return W;
 };
@@ -1,6 +1,8 @@
 #include "freddi_state.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 #include <string>
 
 #include "gsl_const_cgsm.h"
@@ -10,7 +12,17 @@
 #include "orbit.hpp"
 
 
+FreddiState::ObserverGeometry::ObserverGeometry(const Observer& observer):
+		inclination(observer.inclination / 180.0 * M_PI),
+		cosi(std::cos(observer.inclination / 180.0 * M_PI)),
+		distance(observer.distance),
+		cosiOverD2(cosi / m::pow<2>(distance)) {}
+
+
 FreddiState::DiskStructure::DiskStructure(const FreddiArguments &args, const wunc_t& wunc):
+		DiskStructure(args, wunc, initialize_h(args, args.calc->Nx)) {}
+
+FreddiState::DiskStructure::DiskStructure(const FreddiArguments &args, const wunc_t& wunc, vecd&& grid):
 		args(args),
 		Nt(static_cast<size_t>(std::round(args.calc->time / args.calc->tau))),
 		Nx(args.calc->Nx),
@@ -22,9 +34,26 @@ FreddiState::DiskStructure::DiskStructure(const FreddiArguments &args, const wun
 		cosi(std::cos(args.flux->inclination / 180.0 * M_PI)),
 		distance(args.flux->distance),
 		cosiOverD2(cosi / m::pow<2>(distance)),
+		observers(initialize_observers(*args.flux)),
+		xbands(initialize_xbands(*args.flux)),
 		oprel(args.disk->oprel),
-		h(initialize_h(args, Nx)),
+		h(std::move(grid)),
 		R(initialize_R(h, GM)),
+		Qvis_GR_over_Mdot(initialize_Qvis_GR_over_Mdot(args, R)),
+		Qvis_over_F_in(initialize_Qvis_over_F_in(h, GM)),
+		Tph_vis_factor(initialize_Tph_vis_factor(h, GM)),
+		Sigma_factor(initialize_Sigma_factor(h, GM)),
+		Height_factor(initialize_Height_factor(R, oprel)),
+		Kirr_factor(initialize_Kirr_factor(R)),
+		Qx_factor(initialize_Qx_factor(R)),
+		W_factor(initialize_W_factor(h, oprel)),
+		Sigma_minus(initialize_Sigma_minus(*args.basic, R)),
+		Sigma_plus(initialize_Sigma_plus(*args.basic, R)),
+		log_Sigma_plus(initialize_log(Sigma_plus)),
+		log_Sigma_minus_over_plus(initialize_log_ratio(Sigma_minus, Sigma_plus)),
+		v_cooling_front_factor(initialize_v_cooling_front_factor(*args.basic, R)),
+		v_cooling_front_sigma_exp(initialize_v_cooling_front_sigma_exp(*args.basic)),
+		compact_space_scheme(initialize_compact_space_scheme(*args.calc)),
 		wunc(wunc) {}
 
 vecd FreddiState::DiskStructure::initialize_h(const FreddiArguments& args, size_t Nx) {
@@ -52,6 +81,162 @@ vecd FreddiState::DiskStructure::initialize_R(const vecd& h, double GM) {
 	return R;
 }
 
+std::vector<FreddiState::ObserverGeometry> FreddiState::DiskStructure::initialize_observers(const FluxArguments& flux) {
+	return std::vector<ObserverGeometry>(flux.observers.begin(), flux.observers.end());
+}
+
+Spectrum::FrequencyBands FreddiState::DiskStructure::initialize_xbands(const FluxArguments& flux) {
+	vecd nu1 = {flux.emin};
+	vecd nu2 = {flux.emax};
+	for (const auto& band : flux.xbands) {
+		nu1.push_back(band.emin);
+		nu2.push_back(band.emax);
+	}
+	return {nu1, nu2};
+}
+
+vecd FreddiState::DiskStructure::initialize_Qvis_GR_over_Mdot(const FreddiArguments& args, const vecd& R) {
+	vecd Q(R.size());
+	for (size_t i = 0; i < R.size(); i++) {
+		Q[i] = Spectrum::Qvis_GR_over_Mdot(R[i], args.basic->kerr, args.basic->Mx);
+	}
+	return Q;
+}
+
+vecd FreddiState::DiskStructure::initialize_Qvis_over_F_in(const vecd& h, double GM) {
+	vecd Q(h.size());
+	for (size_t i = 0; i < h.size(); i++) {
+		Q[i] = 3. / (8. * M_PI) * m::pow<4>(GM) / m::pow<7>(h[i]);
+	}
+	return Q;
+}
+
+vecd FreddiState::DiskStructure::initialize_Tph_vis_factor(const vecd& h, double GM) {
+	vecd x(h.size());
+	for (size_t i = 0; i < h.size(); i++) {
+		x[i] = GM * std::pow(h[i], -1.75) * std::pow(3. / (8. * M_PI) / GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT, 0.25);
+	}
+	return x;
+}
+
+vecd FreddiState::DiskStructure::initialize_Sigma_factor(const vecd& h, double GM) {
+	vecd x(h.size());
+	for (size_t i = 0; i < h.size(); i++) {
+		x[i] = m::pow<2>(GM) / (4. * M_PI * m::pow<3>(h[i]));
+	}
+	return x;
+}
+
+vecd FreddiState::DiskStructure::initialize_Height_factor(const vecd& R, const OpacityRelated& oprel) {
+	vecd x(R.size());
+	for (size_t i = 0; i < R.size(); i++) {
+		x[i] = oprel.Height_R_factor(R[i]);
+	}
+	return x;
+}
+
+vecd FreddiState::DiskStructure::initialize_Kirr_factor(const vecd& R) {
+	vecd x(R.size());
+	for (size_t i = 0; i < R.size(); i++) {
+		x[i] = 1. / (R[i] * 0.05);
+	}
+	return x;
+}
+
+vecd FreddiState::DiskStructure::initialize_Qx_factor(const vecd& R) {
+	vecd x(R.size());
+	for (size_t i = 0; i < R.size(); i++) {
+		x[i] = 1. / (4. * M_PI * m::pow<2>(R[i]));
+	}
+	return x;
+}
+
+vecd FreddiState::DiskStructure::initialize_W_factor(const vecd& h, const OpacityRelated& oprel) {
+	vecd x(h.size());
+	for (size_t i = 0; i < h.size(); i++) {
+		x[i] = std::pow(h[i], oprel.n) / (1. - oprel.m) / oprel.D;
+	}
+	return x;
+}
+
+vecd FreddiState::DiskStructure::initialize_Sigma_minus(const BasicDiskBinaryArguments& basic, const vecd& R) {
+	vecd x(R.size());
+	for (size_t i = 0; i < R.size(); i++) {
+		x[i] = Sigma_minus_at(basic, R[i]);
+	}
+	return x;
+}
+
+vecd FreddiState::DiskStructure::initialize_Sigma_plus(const BasicDiskBinaryArguments& basic, const vecd& R) {
+	vecd x(R.size());
+	for (size_t i = 0; i < R.size(); i++) {
+		x[i] = Sigma_plus_at(basic, R[i]);
+	}
+	return x;
+}
+
+vecd FreddiState::DiskStructure::initialize_log(const vecd& x) {
+	vecd y(x.size());
+	for (size_t i = 0; i < x.size(); i++) {
+		y[i] = std::log(x[i]);
+	}
+	return y;
+}
+
+vecd FreddiState::DiskStructure::initialize_log_ratio(const vecd& numerator, const vecd& denominator) {
+	vecd y(numerator.size());
+	for (size_t i = 0; i < numerator.size(); i++) {
+		y[i] = std::log(numerator[i] / denominator[i]);
+	}
+	return y;
+}
+
+vecd FreddiState::DiskStructure::initialize_v_cooling_front_factor(const BasicDiskBinaryArguments& basic, const vecd& R) {
+	vecd x(R.size());
+	for (size_t i = 0; i < R.size(); i++) {
+		x[i] = v_cooling_front_factor_at(basic, R[i]);
+	}
+	return x;
+}
+
+double FreddiState::DiskStructure::initialize_v_cooling_front_sigma_exp(const BasicDiskBinaryArguments& basic) {
+	return 0.69 * std::log((basic.alphacold / 0.05) / (basic.alpha / 0.2));
+}
+
+bool FreddiState::DiskStructure::initialize_compact_space_scheme(const CalculationArguments& calc) {
+	if (calc.space_scheme != "central" && calc.space_scheme != "compact") {
+		throw std::invalid_argument("Wrong space_scheme");
+	}
+	return calc.space_scheme == "compact";
+}
+
+double FreddiState::DiskStructure::Sigma_minus_at(const BasicDiskBinaryArguments& basic, const double r) {
+	// Lasota et al., A&A 486, 523–528 (2008), Eq A.1, DOI: 10.1051/0004-6361:200809658
+	return 74.6 * std::pow(basic.alphacold / 0.1, -0.83) * std::pow(r / 1e10, 1.18)
+		* std::pow(basic.Mx / GSL_CONST_CGSM_SOLAR_MASS, -0.40);
+}
+
+double FreddiState::DiskStructure::Sigma_plus_at(const BasicDiskBinaryArguments& basic, const double r) {
+	// Lasota et al., A&A 486, 523–528 (2008), Eq A.1, DOI: 10.1051/0004-6361:200809658
+	return 39.9 * std::pow(basic.alpha / 0.1, -0.80) * std::pow(r / 1e10, 1.11)
+		* std::pow(basic.Mx / GSL_CONST_CGSM_SOLAR_MASS, -0.37);
+}
+
+double FreddiState::DiskStructure::v_cooling_front_factor_at(const BasicDiskBinaryArguments& basic, const double r) {
+	// Ludwig et al., A&A 290, 473-486 (1994), section 3, the part of the cooling-front velocity which is
+	// independent of sigma = log(Sigma / Sigma_plus) / log(Sigma_minus / Sigma_plus)
+	// units: cm/s
+	return 1e5
+		* std::pow(basic.alpha / 0.2, 0.85)
+		* std::pow(basic.alphacold / 0.05, 0.05)
+		* std::pow(r / 1e10, 0.035)
+		* std::pow(basic.Mx / GSL_CONST_CGSM_SOLAR_MASS, -0.012);
+}
+
+double FreddiState::DiskStructure::v_cooling_front_sigma_polynomial(const double sigma) {
+	return 1.439 - 5.305 * sigma + 10.440 * m::pow<2>(sigma) - 10.55 * m::pow<3>(sigma) + 4.142 * m::pow<4>(sigma);
+}
+
 
 FreddiState::CurrentState::CurrentState(const DiskStructure& str):
 		Mdot_out(str.args.disk->Mdotout),
@@ -59,6 +244,7 @@ FreddiState::CurrentState::CurrentState(const DiskStructure& str):
 		i_t(0),
 		first(initializeFirst(str)),
 		last(str.Nx - 1),
+		h_hot(str.h[str.Nx - 1]),
 		F(initializeF(str)),
 		F_in(0) {}
 
@@ -74,9 +260,7 @@ vecd FreddiState::CurrentState::initializeF(const DiskStructure& str) {
 FreddiState::FreddiState(const FreddiArguments& args, const wunc_t& wunc):
 		str_(new DiskStructure(args, wunc)),
 		current_(*str_),
-		disk_irr_source_(initializeFreddiIrradiationSource(args.irr->angular_dist_disk)),
-		star_roche_lobe_(str_->semiaxis, args.basic->Mopt / args.basic->Mx, args.basic->roche_lobe_fill),
-		star_({}, args.basic->Topt, star_roche_lobe_, args.calc->starlod) {
+		disk_irr_source_(initializeFreddiIrradiationSource(args.irr->angular_dist_disk)) {
 	initializeWind();
 }
 
@@ -87,8 +271,8 @@ FreddiState::FreddiState(const FreddiState& other):
 		opt_str_(other.opt_str_),
 		wind_(other.wind_->clone()),
 		disk_irr_source_(other.disk_irr_source_),
-		star_roche_lobe_(other.star_roche_lobe_),
-		star_(other.star_) {}
+		star_(other.star_),
+		star_sources_outdated_(other.star_sources_outdated_) {}
 
 
 void FreddiState::initializeWind() {
@@ -133,8 +317,102 @@ std::shared_ptr<FreddiState::BasicFreddiIrradiationSource> FreddiState::initiali
 }
 
 
+void FreddiState::DiskOptionalStructure::invalidate() {
+	Mdisk.reset();
+	Lx.reset();
+	Mdot_wind.reset();
+	for (auto x : {&W, &Tph, &Qx, &Tph_vis, &Tph_X, &Tirr, &Kirr, &Sigma, &Height, &Lx_bands, &Inu, &Inu_cold}) {
+		x->reset();
+	}
+	Fnu_star.reset();
+}
+
+
 void FreddiState::invalidate_optional_structure() {
-	opt_str_ = DiskOptionalStructure();
+	opt_str_.invalidate();
+}
+
+
+void FreddiState::truncate_optional_structure(const size_t old_last) {
+	// Cells (last, old_last] became cold, F, first and Mdot_in are the same
+	const size_t begin = last() + 1;
+	const size_t end = old_last + 1;
+	for (auto x : {&opt_str_.W, &opt_str_.Sigma, &opt_str_.Tph_vis, &opt_str_.Tph_X}) {
+		if (*x) {
+			std::fill((*x)->begin() + begin, (*x)->begin() + end, 0.0);
+		}
+	}
+	if (opt_str_.Height) {
+		calculate_irradiation(begin, end);
+	}
+	opt_str_.Mdisk.reset();
+	opt_str_.Lx.reset();
+	opt_str_.Lx_bands.reset();
+	opt_str_.Mdot_wind.reset();
+	opt_str_.Fnu_star.reset();
+	opt_str_.Inu.reset();
+	opt_str_.Inu_cold.reset();
+}
+
+
+static double linear_interpolation(const vecd& x, const vecd& y, const double x0) {
+	const size_t j = std::upper_bound(x.begin() + 1, x.end() - 1, x0) - x.begin();
+	return y[j - 1] + (y[j] - y[j - 1]) * (x0 - x[j - 1]) / (x[j] - x[j - 1]);
+}
+
+void FreddiState::replace_grid(vecd&& new_h, const size_t new_last) {
+	// Hot disk profile including the boundary node at h_hot()
+	vecd hot_h(h().begin(), h().begin() + last() + 1);
+	vecd hot_F(F().begin(), F().begin() + last() + 1);
+	if (has_front_node()) {
+		hot_h.push_back(h_hot());
+		hot_F.push_back(F()[last() + 1]);
+	}
+
+	const double exp_F = 1. - oprel().m;
+	const auto Sigma_over_F_power = [this, exp_F](const double hh) {
+		return std::pow(hh, oprel().n) / exp_F / oprel().D * m::pow<2>(GM()) / (4. * M_PI * m::pow<3>(hh));
+	};
+	const auto hot_mass = [this, &Sigma_over_F_power, exp_F](const vecd& hh, const vecd& FF, const size_t begin, const size_t end) {
+		vecd RR(hh.size()), Sigma(hh.size(), 0.);
+		for (size_t i = 0; i < hh.size(); ++i) {
+			RR[i] = m::pow<2>(hh[i]) / GM();
+			if (i >= begin && i < end) {
+				Sigma[i] = Sigma_over_F_power(hh[i]) * std::pow(std::abs(FF[i]), exp_F);
+			}
+		}
+		return disk_radial_trapz(RR, Sigma, first(), hh.size() - 1);
+	};
+	const double old_mass = hot_mass(hot_h, hot_F, first(), hot_h.size());
+
+	vecd new_F(new_h.size());
+	for (size_t i = 0; i <= first(); ++i) {
+		new_F[i] = F()[i];
+	}
+	for (size_t i = first() + 1; i <= new_last; ++i) {
+		new_F[i] = linear_interpolation(hot_h, hot_F, new_h[i]);
+	}
+	for (size_t i = new_last + 1; i < new_h.size(); ++i) {
+		new_F[i] = linear_interpolation(h(), F(), new_h[i]);
+	}
+	// W is a power of F, so a common factor of inner F values conserves the trapezoidal mass exactly
+	const vecd new_hot_h(new_h.begin(), new_h.begin() + new_last + 1);
+	const double boundary_mass = hot_mass(new_hot_h, new_F, first(), first() + 1);
+	const double inner_mass = hot_mass(new_hot_h, new_F, first() + 1, new_last + 1);
+	if (inner_mass > 0. && old_mass > boundary_mass) {
+		const double factor = std::pow((old_mass - boundary_mass) / inner_mass, 1. / exp_F);
+		for (size_t i = first() + 1; i <= new_last; ++i) {
+			new_F[i] *= factor;
+		}
+	}
+
+	str_.reset(new DiskStructure(args(), wunc(), std::move(new_h)));
+	current_.F = std::move(new_F);
+	current_.last = new_last;
+	current_.h_hot = h()[new_last];
+	invalidate_optional_structure();
+	initializeWind();
+	invalidate_star_sources();
 }
 
 
@@ -147,16 +425,41 @@ void FreddiState::replaceArgs(const FreddiArguments &args) {
 void FreddiState::step(double tau) {
 	set_Mdot_in_prev();
 	invalidate_optional_structure();
-	current_.i_t ++;
 	current_.t += tau;
+	// i_t is the number of whole time steps since init_time: a quiescent step covers several of them, see
+	// FreddiEvolution::quiescent_step_factor, and a step shortened to land on an output moment can cover none
+	current_.i_t = static_cast<size_t>(std::floor((t() - args().calc->init_time) / args().calc->tau + 1e-6));
 	wind_->update(*this);
 }
 
 
-double FreddiState::Mdot_in() const {
+// Derivative at x[i] of the Lagrange polynomial through x[i], ..., x[i + n - 1]
+static double one_sided_derivative(const vecd& x, const vecd& y, const size_t i, const size_t n) {
+	double derivative = 0.;
+	for (size_t j = i + 1; j < i + n; ++j) {
+		double weight = 1. / (x[j] - x[i]);
+		for (size_t k = i + 1; k < i + n; ++k) {
+			if (k != j) {
+				weight *= (x[i] - x[k]) / (x[j] - x[k]);
+			}
+		}
+		derivative += weight * (y[j] - y[i]);
+	}
+	return derivative;
+}
+
+double FreddiState::dF_dh_in() const {
+	// The two-point derivative would dominate the error of the compact scheme
+	if (compact_space_scheme() && last() >= first() + 4) {
+		return one_sided_derivative(h(), F(), first(), 5);
+	}
 	return (F()[first() + 1] - F()[first()]) / (h()[first() + 1] - h()[first()]);
 }
 
+double FreddiState::Mdot_in() const {
+	return dF_dh_in();
+}
+
 
 double FreddiState::Lbol_disk() const {
 	return eta() * Mdot_in() * m::pow<2>(GSL_CONST_CGSM_SPEED_OF_LIGHT);
@@ -168,17 +471,36 @@ double FreddiState::phase_opt() const {
 }
 
 
+void FreddiState::lazy_xray_luminosities() {
+	auto& L = opt_str_.Lx_bands.emplace(xbands().size());
+	Spectrum::disk_radial_Planck_nu1_nu2(R(), Tph_X(), first(), last(), xbands(), L, 1e-4);
+	for (auto& x : L) {
+		// 2 pi, see Luminosity()
+		x *= 2. * M_PI / m::pow<4>(args().flux->colourfactor);
+	}
+	// xbands()[0] is the main band [emin, emax]
+	opt_str_.Lx = L.front();
+	L.erase(L.begin());
+}
+
 double FreddiState::Lx() {
 	if (!opt_str_.Lx) {
-		opt_str_.Lx = Luminosity(Tph_X(), args().flux->emin, args().flux->emax) / m::pow<4>(args().flux->colourfactor);
+		lazy_xray_luminosities();
 	}
 	return *opt_str_.Lx;
 }
 
+const vecd& FreddiState::Lx_bands() {
+	if (!opt_str_.Lx_bands) {
+		lazy_xray_luminosities();
+	}
+	return *opt_str_.Lx_bands;
+}
+
 
 const vecd& FreddiState::W() {
 	if (!opt_str_.W) {
-		auto x = wunc()(h(), F(), first(), last());
+		auto x = wunction(h(), F(), first(), last());
 		x.resize(Nx(), 0.0);
 		opt_str_.W = std::move(x);
 	}
@@ -188,12 +510,11 @@ const vecd& FreddiState::W() {
 
 const vecd& FreddiState::Sigma() {
 	if (!opt_str_.Sigma) {
-		vecd x(Nx());
 		const vecd& WW = W();
+		vecd& x = opt_str_.Sigma.emplace(Nx());
 		for (size_t i = first(); i < Nx(); i++) {
-			x[i] = WW[i] * m::pow<2>(GM()) / (4. * M_PI * m::pow<3>(h()[i]));
+			x[i] = WW[i] * str_->Sigma_factor[i];
 		}
-		opt_str_.Sigma = std::move(x);
 	}
 	return *opt_str_.Sigma;
 }
@@ -201,13 +522,7 @@ const vecd& FreddiState::Sigma() {
 
 const vecd& FreddiState::Tph() {
 	if (!opt_str_.Tph) {
-		vecd x(Nx());
-		const vecd& Tvis = Tph_vis();
-		const vecd& QxQx = Qx();
-		for (size_t i = first(); i < Nx(); i++) {
-			x[i] = std::pow(m::pow<4>(Tvis[i]) + QxQx[i] / GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT, 0.25);
-		}
-		opt_str_.Tph = std::move(x);
+		calculate_irradiation(first(), Nx());
 	}
 	return *opt_str_.Tph;
 }
@@ -215,12 +530,7 @@ const vecd& FreddiState::Tph() {
 
 const vecd& FreddiState::Tirr() {
 	if (!opt_str_.Tirr) {
-		vecd x(Nx());
-		const vecd& QxQx = Qx();
-		for (size_t i = first(); i < Nx(); i++) {
-			x[i] = std::pow(QxQx[i] / GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT, 0.25);
-		}
-		opt_str_.Tirr = std::move(x);
+		calculate_irradiation(first(), Nx());
 	}
 	return *opt_str_.Tirr;
 }
@@ -228,30 +538,15 @@ const vecd& FreddiState::Tirr() {
 
 const vecd& FreddiState::Qx() {
 	if (!opt_str_.Qx) {
-		vecd x(Nx());
-		const vecd& K = Kirr();
-		const vecd& H = Height();
-		const double Lbol = Lbol_disk();
-		for (size_t i = first(); i < Nx(); i++) {
-			x[i] = K[i] * Lbol * angular_dist_disk(H[i] / R()[i]) / (4. * M_PI * m::pow<2>(R()[i]));
-		}
-		opt_str_.Qx = std::move(x);
+		calculate_irradiation(first(), Nx());
 	}
 	return *opt_str_.Qx;
 }
 
 
 const vecd& FreddiState::Kirr() {
-	if(!opt_str_.Kirr) {
-		vecd x(Nx());
-		const vecd& H = Height();
-		for (size_t i = first(); i <= last(); i++) {
-			x[i] = args().irr->Cirr * std::pow(H[i] / (R()[i] * 0.05), args().irr->irrindex);
-		}
-		for (size_t i = last() + 1; i < Nx(); i++) {
-			x[i] = args().irr->Cirr_cold * std::pow(H[i] / (R()[i] * 0.05), args().irr->irrindex_cold);
-		}
-		opt_str_.Kirr = std::move(x);
+	if (!opt_str_.Kirr) {
+		calculate_irradiation(first(), Nx());
 	}
 	return *opt_str_.Kirr;
 }
@@ -259,49 +554,48 @@ const vecd& FreddiState::Kirr() {
 
 const vecd& FreddiState::Height() {
 	if (!opt_str_.Height) {
-		vecd x(Nx());
-		for (size_t i = first(); i <= last(); i++) {
-			x[i] = oprel().Height(R()[i], F()[i]);
-		}
-		for (size_t i = last() + 1; i < Nx(); i++) {
-			x[i] = args().irr->height_to_radius_cold * R()[i];
-		}
-		opt_str_.Height = std::move(x);
+		calculate_irradiation(first(), Nx());
 	}
 	return *opt_str_.Height;
 }
 
 
+void FreddiState::calculate_irradiation(const size_t begin, const size_t end) {
+	const double Lbol = Lbol_disk();
+	visit_irradiation_source(*disk_irr_source_, [this, Lbol, begin, end](const auto& disk_source) {
+		fused_irradiation([Lbol, &disk_source](const double mu) -> double {
+			return Lbol * disk_source.angular_dist(mu);
+		}, begin, end);
+	});
+}
+
+
 const vecd& FreddiState::Tph_vis() {
 	if (!opt_str_.Tph_vis) {
-		vecd x(Nx(), 0.0);
+		vecd& x = opt_str_.Tph_vis.emplace(Nx());
 		for (size_t i = first(); i <= last(); i++) {
-			x[i] = (GM() * std::pow(h()[i], -1.75)
-					* std::pow(3. / (8. * M_PI) * F()[i] / GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT, 0.25));
+			x[i] = str_->Tph_vis_factor[i] * std::pow(F()[i], 0.25);
 		}
-		opt_str_.Tph_vis = std::move(x);
 	}
 	return *opt_str_.Tph_vis;
 }
 
 const vecd& FreddiState::Tph_X() {
 	if (!opt_str_.Tph_X) {
-		vecd x(Nx(), 0.0);
+		vecd& x = opt_str_.Tph_X.emplace(Nx());
 		const double Mdot = std::fabs((F()[first()+1] - F()[first()]) / (h()[first()+1] - h()[first()]));
+		const double F_in = F()[first()];
 		for (size_t i = first(); i <= last(); i++) {
-			//
-
 			// Qvis due to non-zero Fin:
-			x[i] =  3. / (8. * M_PI) * m::pow<4>(GM()) / m::pow<7>(h()[i]) * F()[first()];
+			x[i] = str_->Qvis_over_F_in[i] * F_in;
 
 			// Qvis due to non-zero Mdot:  = sigma * Trel(dotM)^4
 			//      assume that Mdot ~= const where X-rays are generated
 			//      dotM = dF/dh
-			x[i] += m::pow<4>(Spectrum::T_GR(R()[i], args().basic->kerr, args().basic->Mx, Mdot)) * GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT;
+			x[i] += str_->Qvis_GR_over_Mdot[i] * Mdot;
 
 			x[i] = args().flux->colourfactor * std::pow( x[i] / GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT , 0.25);
 		}
-		opt_str_.Tph_X = std::move(x);
 	}
 	return *opt_str_.Tph_X;
 }
@@ -347,12 +641,109 @@ IrradiatedStar::sources_t FreddiState::star_irr_sources() {
 }
 
 
+Star& FreddiState::star() {
+	if (!star_) {
+		const RocheLobe roche_lobe(semiaxis(), args().basic->Mopt / args().basic->Mx, args().basic->roche_lobe_fill);
+		star_.emplace(IrradiatedStar::sources_t(), args().basic->Topt, roche_lobe, args().calc->starlod);
+	}
+	if (star_sources_outdated_) {
+		star_->set_sources(star_irr_sources());
+		star_sources_outdated_ = false;
+	}
+	return *star_;
+}
+
+
 double FreddiState::flux_star(const double lambda, const double phase) {
-	return star_.luminosity({inclination(), phase}, lambda) / (FOUR_M_PI * m::pow<2>(distance()));
+	return star().luminosity({inclination(), phase}, lambda) / (FOUR_M_PI * m::pow<2>(distance()));
 }
 
 double FreddiState::flux_star(const Passband& passband, const double phase) {
-	return star_.luminosity({inclination(), phase}, passband) / (FOUR_M_PI * m::pow<2>(distance()));
+	return star().luminosity({inclination(), phase}, passband) / (FOUR_M_PI * m::pow<2>(distance()));
+}
+
+std::vector<vecd> FreddiState::flux_star(const vecd& lambdas, const std::vector<Passband>& passbands, const vecd& phases) {
+	std::vector<UnitVec3> directions;
+	directions.reserve(phases.size());
+	for (const double phase : phases) {
+		directions.emplace_back(inclination(), phase);
+	}
+	auto fluxes = star().luminosities(directions, lambdas, passbands);
+	for (auto& fluxes_phase : fluxes) {
+		for (auto& x : fluxes_phase) {
+			x /= FOUR_M_PI * m::pow<2>(distance());
+		}
+	}
+	return fluxes;
+}
+
+std::vector<std::vector<vecd>> FreddiState::flux_star(const vecd& lambdas, const std::vector<Passband>& passbands, const vecd& phases,
+		const std::vector<ObserverGeometry>& observers) {
+	std::vector<UnitVec3> directions;
+	directions.reserve(observers.size() * phases.size());
+	for (const auto& observer : observers) {
+		for (const double phase : phases) {
+			directions.emplace_back(observer.inclination, phase);
+		}
+	}
+	const auto luminosities = star().luminosities(directions, lambdas, passbands);
+	std::vector<std::vector<vecd>> fluxes(observers.size());
+	for (size_t i_obs = 0; i_obs < observers.size(); ++i_obs) {
+		for (size_t i_phase = 0; i_phase < phases.size(); ++i_phase) {
+			auto& fluxes_phase = fluxes[i_obs].emplace_back(luminosities[i_obs * phases.size() + i_phase]);
+			for (auto& x : fluxes_phase) {
+				x /= FOUR_M_PI * m::pow<2>(observers[i_obs].distance);
+			}
+		}
+	}
+	return fluxes;
+}
+
+const std::vector<std::vector<vecd>>& FreddiState::lazy_star_fluxes() {
+	if (!opt_str_.Fnu_star) {
+		std::vector<ObserverGeometry> all_observers = {ObserverGeometry(Observer(args().flux->inclination, args().flux->distance))};
+		all_observers.insert(all_observers.end(), observers().begin(), observers().end());
+		opt_str_.Fnu_star = flux_star(lambdas(), args().flux->passbands, {phase_opt(), 0.0, M_PI}, all_observers);
+	}
+	return *opt_str_.Fnu_star;
+}
+
+template <FreddiState::DiskIntegrationRegion Region> const vecd& FreddiState::lazy_intensities(LazyArray& intensities) {
+	if (!intensities) {
+		const auto& passbands = args().flux->passbands;
+		// Wavelengths of all passbands follow lambdas(), so the disk is integrated over once
+		vecd all_lambdas(lambdas());
+		for (const auto& passband : passbands) {
+			all_lambdas.insert(all_lambdas.end(), passband.lambdas.begin(), passband.lambdas.end());
+		}
+		vecd I;
+		I_lambda<Region>(all_lambdas, I);
+		auto& Inu = intensities.emplace(lambdas().size() + passbands.size());
+		for (size_t j = 0; j < lambdas().size(); ++j) {
+			Inu[j] = I[j] * m::pow<2>(lambdas()[j]) / GSL_CONST_CGSM_SPEED_OF_LIGHT;
+		}
+		size_t offset = lambdas().size();
+		for (size_t i_pb = 0; i_pb < passbands.size(); ++i_pb) {
+			const auto& passband = passbands[i_pb];
+			Inu[lambdas().size() + i_pb] = trapz(
+					passband.lambdas,
+					[&I, &passband, offset](const size_t i) -> double {
+						return I[offset + i] * passband.transmissions[i];
+					},
+					0,
+					passband.data.size() - 1) / passband.t_dnu;
+			offset += passband.lambdas.size();
+		}
+	}
+	return *intensities;
+}
+
+const vecd& FreddiState::Inu() {
+	return lazy_intensities<HotRegion>(opt_str_.Inu);
+}
+
+const vecd& FreddiState::Inu_cold() {
+	return lazy_intensities<ColdRegion>(opt_str_.Inu_cold);
 }
 
 
@@ -685,15 +1076,11 @@ std::unique_ptr<IrrSource> FreddiState::PlaneFreddiIrradiationSource::irr_source
 }
 
 double FreddiState::Sigma_minus(double r) const {
-	// Lasota et al., A&A 486, 523–528 (2008), Eq A.1, DOI: 10.1051/0004-6361:200809658
-	return 74.6 * std::pow(args().basic->alphacold / 0.1, -0.83) * std::pow(r / 1e10, 1.18)
-		* std::pow(args().basic->Mx / GSL_CONST_CGSM_SOLAR_MASS, -0.40);
+	return DiskStructure::Sigma_minus_at(*args().basic, r);
 }
 
 double FreddiState::Sigma_plus(double r) const {
-	// Lasota et al., A&A 486, 523–528 (2008), Eq A.1, DOI: 10.1051/0004-6361:200809658
-	return 39.9 * std::pow(args().basic->alpha / 0.1, -0.80) * std::pow(r / 1e10, 1.11)
-		* std::pow(args().basic->Mx / GSL_CONST_CGSM_SOLAR_MASS, -0.37);
+	return DiskStructure::Sigma_plus_at(*args().basic, r);
 }
 
 double FreddiState::v_cooling_front(double r) {
@@ -702,16 +1089,13 @@ double FreddiState::v_cooling_front(double r) {
         // units: cm/s
         const double Sigma_plus_ = Sigma_plus(r);
         const double sigma =  std::log( Sigma()[last()] / Sigma_plus_ ) /  std::log( Sigma_minus(r)/Sigma_plus_ ) ;
-        return 1e5 * (1.439-5.305*sigma+10.440*m::pow<2>(sigma)-10.55*m::pow<3>(sigma)+4.142*m::pow<4>(sigma))
-               * std::pow(args().basic->alpha / 0.2, 0.85-0.69*sigma) 
-               * std::pow(args().basic->alphacold / 0.05, 0.05+0.69*sigma)
-               * std::pow(r / 1e10, 0.035)
-               * std::pow(args().basic->Mx / GSL_CONST_CGSM_SOLAR_MASS, -0.012);
+        return DiskStructure::v_cooling_front_factor_at(*args().basic, r) * DiskStructure::v_cooling_front_sigma_polynomial(sigma)
+               * std::exp(str_->v_cooling_front_sigma_exp * sigma);
 }
 
 double FreddiState::R_cooling_front(double r)  {
         // previous location of Rhot moves with the cooling-front velocity:
-        return  R()[last()] - v_cooling_front(r) * args().calc->tau;       
+        return  R_hot() - v_cooling_front(r) * args().calc->tau;       
         //return  R()[last()] - v_cooling_front(R()[last()]) * args().calc->tau  ; 
         // this variant leads to more abrupt evolution, since the front velocity is larger
 }
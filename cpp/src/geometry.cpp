@@ -3,18 +3,11 @@
 #include <geometry.hpp>
 
 
-Vec3::Vec3(const std::array<double, 3>& cartesian, const double length):
-		cartesian_(cartesian), length_(length) {}
-
 Vec3::Vec3(const std::array<double, 3>& cartesian):
-		Vec3(cartesian, lengthFromCartesian(cartesian)) {}
+		cartesian_(cartesian) {}
 
 Vec3::Vec3(const double x, const double y, const double z):
-		Vec3({x, y, z}, lengthFromCartesian({x, y, z})) {}
-
-double Vec3::lengthFromCartesian(const std::array<double, 3>& cartesian) {
-	return std::sqrt(cartesian[0] * cartesian[0] + cartesian[1] * cartesian[1] + cartesian[2] * cartesian[2]);
-}
+		cartesian_{x, y, z} {}
 
 double Vec3::x() const {
 	return cartesian_[0];
@@ -29,7 +22,11 @@ double Vec3::z() const {
 }
 
 double Vec3::length() const {
-	return length_;
+	return std::sqrt(squaredLength());
+}
+
+double Vec3::squaredLength() const {
+	return dotProduct(*this);
 }
 
 const std::array<double, 3>& Vec3::cartesian() const {
@@ -64,7 +61,6 @@ Vec3& Vec3::operator*=(const double factor) {
 	for (auto& component : cartesian_) {
 		component *= factor;
 	}
-	length_ *= factor;
 	return *this;
 }
 
@@ -104,12 +100,13 @@ Vec3 Vec3::crossProduct(const Vec3& other) const {
 
 
 UnitVec3::UnitVec3(const Vec3& vec3):
-		Vec3(vec3 / vec3.length()) {
-	length_ = 1.0;
-}
+		UnitVec3(vec3, vec3.length()) {}
+
+UnitVec3::UnitVec3(const Vec3& vec3, const double vec3_length):
+		Vec3(vec3 / vec3_length) {}
 
 UnitVec3::UnitVec3(const double theta, const double phi):
-		Vec3(cartesianFromSpherical(theta, phi), 1.0) {}
+		Vec3(cartesianFromSpherical(theta, phi)) {}
 
 std::array<double, 3> UnitVec3::cartesianFromSpherical(const double theta, const double phi) {
 	const double sin_theta = std::sin(theta);
@@ -121,16 +118,19 @@ std::array<double, 3> UnitVec3::cartesianFromSpherical(const double theta, const
 }
 
 
-Triangle::Triangle(std::array<Vec3, 3>&& vertices):
-		Triangle(vertices) {}
-
-Triangle::Triangle(const std::array<Vec3, 3>& vertices):
+Triangle::Triangle(const std::array<Vec3, 3>& vertices, const Vec3& doubled_area_normal):
 		vertices_(vertices),
-		area_(0.5 * (vertices[1] - vertices[0]).crossProduct(vertices[2] - vertices[1]).length()),
+		area_(0.5 * doubled_area_normal.length()),
 		// Use incenter instead?
 		// https://en.wikipedia.org/wiki/Incircle_and_excircles_of_a_triangle#Cartesian_coordinates
 		center_((vertices[0] + vertices[1] + vertices[2]) / 3.0),
-		normal_{(vertices[1] - vertices[0]).crossProduct(vertices[2] - vertices[1])} {}
+		normal_(doubled_area_normal, 2.0 * area_) {}
+
+Triangle::Triangle(std::array<Vec3, 3>&& vertices):
+		Triangle(vertices) {}
+
+Triangle::Triangle(const std::array<Vec3, 3>& vertices):
+		Triangle(vertices, (vertices[1] - vertices[0]).crossProduct(vertices[2] - vertices[1])) {}
 
 Triangle::Triangle(const Vec3& vertex1, const Vec3& vertex2, const Vec3& vertex3):
 		Triangle{{vertex1, vertex2, vertex3}} {}
@@ -229,6 +229,7 @@ std::vector<Triangle> unit_sphere_triangles(unsigned short lod) {
 	std::vector<Triangle> triangles = polyhedron_triangles<Icosahedron>();
 	for (unsigned short i = lod; i != 0; --i) {
 		std::vector<Triangle> tmp;
+		tmp.reserve(4 * triangles.size());
 		for (const auto& large_triangle : triangles) {
 			for (const auto& small_triangle : large_triangle.divide()) {
 				tmp.push_back(small_triangle.projectedOntoUnitSphere());
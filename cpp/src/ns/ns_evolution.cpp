@@ -1,4 +1,5 @@
 #include <exception>
+#include <stdexcept>
 
 #include "exceptions.hpp"
 #include "ns/ns_evolution.hpp"
@@ -325,6 +326,10 @@ FreddiNeutronStarEvolution::FreddiNeutronStarEvolution(const FreddiNeutronStarAr
 		ns_irr_source_(initializeFreddiIrradiationSource(args.irr_ns->angular_dist_ns)),
 		fp_(initializeNsMdotFraction(*args.ns)),
 		eta_ns_(initializeNsAccretionEfficiency(*args.ns, this)) {
+	// Fmagn and other neutron star structure are bound to the initial grid
+	if (args.calc->regrid_tolerance > 0.) {
+		throw std::invalid_argument("Grid refinement is not supported for neutron star evolution, set regridtol to zero");
+	}
 	// Change initial condition due presence of magnetic field torque. It can spoil user-defined initial disk
 	// parameters, such as mass or Fout
 	if (inverse_beta() <= 0.) {  // F_in is non-zero, Fmagn is zero everywhere
@@ -405,17 +410,44 @@ double FreddiNeutronStarEvolution::Lx_ns() {
 }
 
 
+void FreddiNeutronStarEvolution::lazy_ns_xray_luminosities() {
+	vecd intensities;
+	xbands().Planck_nu1_nu2(T_hot_spot(), intensities, 1e-4, redshift());
+	for (auto& x : intensities) {
+		x *= 4*M_PI * hot_spot_area() * m::pow<2>(R_x()) * M_PI;
+	}
+	// xbands()[0] is the main band [emin, emax]
+	ns_opt_str_.Lx_ns_rest_frame = intensities.front();
+	intensities.erase(intensities.begin());
+	ns_opt_str_.Lx_ns_bands_rest_frame = std::move(intensities);
+}
+
+
 double FreddiNeutronStarEvolution::Lx_ns_rest_frame() {
 	if (!ns_opt_str_.Lx_ns_rest_frame) {
-		const double nu_min = args().flux->emin / redshift();
-		const double nu_max = args().flux->emax / redshift();
-		const double intensity = Spectrum::Planck_nu1_nu2(T_hot_spot(), nu_min, nu_max, 1e-4);
-		ns_opt_str_.Lx_ns_rest_frame = 4*M_PI * hot_spot_area() * m::pow<2>(R_x()) * M_PI * intensity;
+		lazy_ns_xray_luminosities();
 	}
 	return *ns_opt_str_.Lx_ns_rest_frame;
 }
 
 
+vecd FreddiNeutronStarEvolution::Lx_ns_bands() {
+	vecd L(Lx_ns_bands_rest_frame());
+	for (auto& x : L) {
+		x *= redshift();
+	}
+	return L;
+}
+
+
+const vecd& FreddiNeutronStarEvolution::Lx_ns_bands_rest_frame() {
+	if (!ns_opt_str_.Lx_ns_bands_rest_frame) {
+		lazy_ns_xray_luminosities();
+	}
+	return *ns_opt_str_.Lx_ns_bands_rest_frame;
+}
+
+
 void FreddiNeutronStarEvolution::invalidate_optional_structure() {
 	FreddiEvolution::invalidate_optional_structure();
 	ns_opt_str_ = NeutronStarOptionalStructure();
@@ -463,8 +495,7 @@ void FreddiNeutronStarEvolution::truncateInnerRadius() {
 
 
 double FreddiNeutronStarEvolution::Mdot_in() const {
-	const double dF_dh = (F()[first() + 1] - F()[first()]) / (h()[first() + 1] - h()[first()]);
-	return dF_dh + dFmagn_dh()[first()];
+	return dF_dh_in() + dFmagn_dh()[first()];
 }
 
 double FreddiNeutronStarEvolution::R_Alfven() const {
@@ -487,20 +518,16 @@ vecd FreddiNeutronStarEvolution::windC() const {
 }
 
 
-const vecd& FreddiNeutronStarEvolution::Qx() {
-	if (!opt_str_.Qx) {
-		vecd x(Nx());
-		const vecd& K = Kirr();
-		const vecd& H = Height();
-		const double L_disk = Lbol_disk();
-		const double L_ns = Lbol_ns();
-		for (size_t i = first(); i < Nx(); i++) {
-			const double mu = H[i] / R()[i];
-			x[i] = K[i] * (L_disk * angular_dist_disk(mu) + L_ns * angular_dist_ns(mu)) / (4. * M_PI * m::pow<2>(R()[i]));
-		}
-		opt_str_.Qx = std::move(x);
-	}
-	return *opt_str_.Qx;
+void FreddiNeutronStarEvolution::calculate_irradiation(const size_t begin, const size_t end) {
+	const double L_disk = Lbol_disk();
+	const double L_ns = Lbol_ns();
+	visit_irradiation_source(*disk_irr_source_, [this, L_disk, L_ns, begin, end](const auto& disk_source) {
+		visit_irradiation_source(*ns_irr_source_, [this, L_disk, L_ns, begin, end, &disk_source](const auto& ns_source) {
+			fused_irradiation([L_disk, L_ns, &disk_source, &ns_source](const double mu) -> double {
+				return L_disk * disk_source.angular_dist(mu) + L_ns * ns_source.angular_dist(mu);
+			}, begin, end);
+		});
+	});
 }
 
 /*
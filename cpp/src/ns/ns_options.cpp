@@ -235,7 +235,7 @@ po::options_description NeutronStarSelfIrradiationOptions::description() {
 }
 
 
-FreddiNeutronStarOptions::FreddiNeutronStarOptions(const po::variables_map &vm) {
+FreddiNeutronStarOptions::FreddiNeutronStarOptions(const po::variables_map &vm, PassbandCache* passband_cache) {
 	ns.reset(new NeutronStarOptions(vm));
 
 	general.reset(new GeneralOptions(vm));
@@ -243,7 +243,7 @@ FreddiNeutronStarOptions::FreddiNeutronStarOptions(const po::variables_map &vm)
 	disk.reset(new NeutronStarDiskStructureOptions(vm, *ns, *basic));
 	irr_ns.reset(new NeutronStarSelfIrradiationOptions(vm, *disk));
 	irr = irr_ns;
-	flux.reset(new FluxOptions(vm));
+	flux.reset(new FluxOptions(vm, passband_cache));
 	calc.reset(new CalculationOptions(vm));
 }
 
@@ -9,8 +9,23 @@ std::vector<FileOutputShortField> FreddiNeutronStarFileOutput::initializeShortFi
 	fields.emplace_back("etans", "float", "Accretion efficiency of the neutron star", [freddi]() {return freddi->eta_ns();});
 	fields.emplace_back("Lxns", "erg/s", "X-ray luminosity of the neutron star in the given energy range [emin, emax]", [freddi]() {return freddi->Lx_ns();});
 	fields.emplace_back("Lbolns", "erg/s", "Bolometric luminosity of the neutron star", [freddi]() {return freddi->Lbol_ns();});
-	fields.emplace_back("Fxns", "erg/s/cm^2", "X-ray flux of the neutron star in the given energy range [emin, emax]", [freddi]() {return freddi->Lx_ns() * freddi->angular_dist_ns(freddi->cosi()) / (FOUR_M_PI * m::pow<2>(freddi->distance()));}),
-	fields.emplace_back("Fbolns", "erg/s/cm^2", "Bolometric flux of the neutron star", [freddi]() {return freddi->Lbol_ns() * freddi->angular_dist_ns(freddi->cosi()) / (FOUR_M_PI * m::pow<2>(freddi->distance()));}),
+	fields.emplace_back("Fxns", "erg/s/cm^2", "X-ray flux of the neutron star in the given energy range [emin, emax]", [freddi]() {return freddi->Lx_ns() * freddi->angular_dist_ns(freddi->cosi()) / (FOUR_M_PI * m::pow<2>(freddi->distance()));});
+	fields.emplace_back("Fbolns", "erg/s/cm^2", "Bolometric flux of the neutron star", [freddi]() {return freddi->Lbol_ns() * freddi->angular_dist_ns(freddi->cosi()) / (FOUR_M_PI * m::pow<2>(freddi->distance()));});
+	const auto& xbands = freddi->args().flux->xbands;
+	for (size_t i_band = 0; i_band < xbands.size(); ++i_band) {
+		const auto in_band = FreddiFileOutput::xbandDescription(xbands[i_band]);
+		fields.emplace_back("Lxns" + std::to_string(i_band), "erg/s", "X-ray luminosity of the neutron star" + in_band, [freddi, i_band]() {return freddi->Lx_ns_bands()[i_band];});
+		fields.emplace_back("Fxns" + std::to_string(i_band), "erg/s/cm^2", "X-ray flux of the neutron star" + in_band, [freddi, i_band]() {return freddi->Lx_ns_bands()[i_band] * freddi->angular_dist_ns(freddi->cosi()) / (FOUR_M_PI * m::pow<2>(freddi->distance()));});
+	}
+	for (size_t i_obs = 0; i_obs < freddi->observers().size(); ++i_obs) {
+		const auto suffix = FreddiFileOutput::observerSuffix(i_obs);
+		const auto for_observer = FreddiFileOutput::observerDescription(freddi->observers()[i_obs]);
+		fields.emplace_back("Fxns" + suffix, "erg/s/cm^2", "X-ray flux of the neutron star in the given energy range [emin, emax]" + for_observer, [freddi, i_obs]() {const auto& obs = freddi->observers()[i_obs]; return freddi->Lx_ns() * freddi->angular_dist_ns(obs.cosi) / (FOUR_M_PI * m::pow<2>(obs.distance));});
+		fields.emplace_back("Fbolns" + suffix, "erg/s/cm^2", "Bolometric flux of the neutron star" + for_observer, [freddi, i_obs]() {const auto& obs = freddi->observers()[i_obs]; return freddi->Lbol_ns() * freddi->angular_dist_ns(obs.cosi) / (FOUR_M_PI * m::pow<2>(obs.distance));});
+		for (size_t i_band = 0; i_band < xbands.size(); ++i_band) {
+			fields.emplace_back("Fxns" + std::to_string(i_band) + suffix, "erg/s/cm^2", "X-ray flux of the neutron star" + FreddiFileOutput::xbandDescription(xbands[i_band]) + for_observer, [freddi, i_obs, i_band]() {const auto& obs = freddi->observers()[i_obs]; return freddi->Lx_ns_bands()[i_band] * freddi->angular_dist_ns(obs.cosi) / (FOUR_M_PI * m::pow<2>(obs.distance));});
+		}
+	}
 	fields.emplace_back("Thotspot", "keV", "Temperature of the neutron star 'hot spot'", [freddi]() {return kToKev(freddi->T_hot_spot());});
 	fields.emplace_back("fpin", "float", "Part of accreting matter falling onto the neutron star", [freddi]() {return freddi->fp();});
 	fields.emplace_back("Fmagnin", "dyn*cm", "Magnetic torque at the inner radius of the disk", [freddi]() {return freddi->Fmagn()[freddi->first()];});
@@ -83,7 +83,12 @@ void OpacityRelated::init_OPAL(){
 
 
 double OpacityRelated::Height(double R, double F) const {
-	return R * Height_coef * pow(F, Height_exp_F) * pow(R/1e10, Height_exp_R - Height_exp_F/2.);
+	return Height_R_factor(R) * pow(F, Height_exp_F);
+}
+
+
+double OpacityRelated::Height_R_factor(double R) const {
+	return R * Height_coef * pow(R/1e10, Height_exp_R - Height_exp_F/2.);
 }
 
 
@@ -1,4 +1,5 @@
-#include <algorithm>  // transform
+#include <algorithm>  // sort transform
+#include <fstream>
 #include <vector>
 
 #include <boost/algorithm/string.hpp> // split is_any_of
@@ -15,7 +16,32 @@ GeneralOptions::GeneralOptions(const po::variables_map& vm):
 				vm["precision"].as<unsigned int>(),
 				vm["tempsparsity"].as<unsigned int>(),
 				(vm.count("fulldata") > 0),
-				(vm.count("stdout") > 0)) {}
+				(vm.count("stdout") > 0),
+				outputTimesInitializer(vm)) {
+	if (!output_times.empty() && output_times.front() < dayToS(vm["inittime"].as<double>())) {
+		throw po::invalid_option_value("--outputtimes should not be earlier than --inittime");
+	}
+}
+
+vecd GeneralOptions::outputTimesInitializer(const po::variables_map& vm) {
+	if (vm.count("outputtimes") == 0) {
+		return {};
+	}
+	std::ifstream file(vm["outputtimes"].as<std::string>());
+	if (!file) {
+		throw po::invalid_option_value("Output times file doesn't exist");
+	}
+	vecd times;
+	double t;
+	while (file >> t) {
+		times.push_back(dayToS(t));
+	}
+	if (!file.eof()) {
+		throw po::invalid_option_value("Output times file should contain numbers only");
+	}
+	std::sort(times.begin(), times.end());
+	return times;
+}
 
 po::options_description GeneralOptions::description() {
 	po::options_description od("General options");
@@ -27,7 +53,11 @@ po::options_description GeneralOptions::description() {
 			( "dir,d", po::value<std::string>()->default_value(default_dir), "Choose the directory to write output files. It should exist" )
 			( "precision", po::value<unsigned int>()->default_value(default_output_precision), "Number of digits to print into output files" )
 			( "tempsparsity", po::value<unsigned int>()->default_value(default_temp_sparsity_output), "Output every k-th time moment" )
-			( "fulldata", "Output files PREFIX_%d.dat with radial structure for every time step. Default is to output only PREFIX.dat with global disk parameters for every time step" )
+			( "fulldata", "Output files PREFIX_%d.dat with radial structure for every time step, %d is the index of the time step, or the index of the moment if --outputtimes is given. Default is to output only PREFIX.dat with global disk parameters for every time step" )
+			( "outputtimes", po::value<std::string>(), "Path of a file containing time moments to output instead of every --tempsparsity-th time step, days, separated by spaces or newlines. The time step before every moment is shortened to land on it, moments later than --inittime + --time are ignored" )
+			( "serve", "Run as a server calculating parameter sets read from stdin or from clients of --socket. Every parameter set is a JSON line like {\"id\": \"run1\", \"options\": {\"alpha\": 0.3}, \"times\": [1, 2.5], \"columns\": [\"t\", \"Mdot\"]}, where options override the command line and configuration files, times are output time moments in days, and columns are names of PREFIX.dat columns, all keys are optional. Every result is written as soon as it is ready as a JSON line like {\"id\": \"run1\", \"columns\": [\"t\", \"Mdot\"], \"data\": [[1, 1.2e18], [2.5, 9.8e17]]}, or {\"id\": \"run1\", \"error\": \"...\"}. No output files are written" )
+			( "socket", po::value<std::string>(), "Path of a Unix socket to listen on in --serve mode instead of reading stdin. Results are written back to the client which has sent the parameter set" )
+			( "threads", po::value<unsigned int>()->default_value(0), "Number of threads calculating parameter sets in --serve mode, zero means the number of CPU cores" )
 			;
 	return od;
 }
@@ -282,7 +312,7 @@ po::options_description SelfIrradiationOptions::description() {
 }
 
 
-FluxOptions::FluxOptions(const po::variables_map &vm):
+FluxOptions::FluxOptions(const po::variables_map &vm, PassbandCache* passband_cache):
 		FluxArguments(
 				vm["colourfactor"].as<double>(),
 				kevToHertz(vm["emin"].as<double>()),
@@ -294,7 +324,9 @@ FluxOptions::FluxOptions(const po::variables_map &vm):
 				vm.count("colddiskflux") > 0,
 				vm.count("starflux") > 0,
 				lambdasInitializer(vm),
-				passbandsInitializer(vm)) {}
+				passbandsInitializer(vm, passband_cache),
+				observersInitializer(vm),
+				xbandsInitializer(vm)) {}
 
 vecd FluxOptions::lambdasInitializer(const po::variables_map &vm) {
 	if (vm.count("lambda") == 0) {
@@ -305,7 +337,7 @@ vecd FluxOptions::lambdasInitializer(const po::variables_map &vm) {
 	return lambdas;
 }
 
-std::vector<Passband> FluxOptions::passbandsInitializer(const po::variables_map& vm) {
+std::vector<Passband> FluxOptions::passbandsInitializer(const po::variables_map& vm, PassbandCache* passband_cache) {
 	if (vm.count("passband") == 0) {
 		return {};
 	}
@@ -313,7 +345,11 @@ std::vector<Passband> FluxOptions::passbandsInitializer(const po::variables_map&
 	std::vector<Passband> passbands;
 	for (const auto &filepath : filepaths) {
 		try {
-			passbands.emplace_back(filepath);
+			if (passband_cache != nullptr) {
+				passbands.push_back(passband_cache->get(filepath));
+			} else {
+				passbands.emplace_back(filepath);
+			}
 		} catch (const std::ios_base::failure& e) {
 			throw po::invalid_option_value("Passband file doesn't exist");
 		}
@@ -321,6 +357,58 @@ std::vector<Passband> FluxOptions::passbandsInitializer(const po::variables_map&
 	return passbands;
 }
 
+std::vector<Observer> FluxOptions::observersInitializer(const po::variables_map& vm) {
+	if (vm.count("observer") == 0) {
+		return {};
+	}
+	std::vector<Observer> observers;
+	for (const auto& value : vm["observer"].as<std::vector<std::string>>()) {
+		std::vector<std::string> tokens;
+		boost::split(tokens, value, boost::is_any_of(","));
+		if (tokens.size() != 2) {
+			throw po::invalid_option_value("--observer should be INCLINATION,DISTANCE");
+		}
+		double inclination, distance;
+		try {
+			inclination = std::stod(tokens[0]);
+			distance = std::stod(tokens[1]);
+		} catch (const std::logic_error& e) {
+			throw po::invalid_option_value("--observer should be INCLINATION,DISTANCE");
+		}
+		if (distance <= 0.) {
+			throw po::invalid_option_value("--observer distance should be positive");
+		}
+		observers.emplace_back(inclination, kpcToCm(distance));
+	}
+	return observers;
+}
+
+std::vector<EnergyBand> FluxOptions::xbandsInitializer(const po::variables_map& vm) {
+	if (vm.count("xband") == 0) {
+		return {};
+	}
+	std::vector<EnergyBand> xbands;
+	for (const auto& value : vm["xband"].as<std::vector<std::string>>()) {
+		std::vector<std::string> tokens;
+		boost::split(tokens, value, boost::is_any_of(","));
+		if (tokens.size() != 2) {
+			throw po::invalid_option_value("--xband should be EMIN,EMAX");
+		}
+		double emin, emax;
+		try {
+			emin = std::stod(tokens[0]);
+			emax = std::stod(tokens[1]);
+		} catch (const std::logic_error& e) {
+			throw po::invalid_option_value("--xband should be EMIN,EMAX");
+		}
+		if (!(emin > 0. && emin < emax)) {
+			throw po::invalid_option_value("--xband should satisfy 0 < EMIN < EMAX");
+		}
+		xbands.emplace_back(kevToHertz(emin), kevToHertz(emax));
+	}
+	return xbands;
+}
+
 po::options_description FluxOptions::description() {
 	po::options_description od("Parameters of flux calculation");
 	od.add_options()
@@ -335,6 +423,8 @@ po::options_description FluxOptions::description() {
 			( "starflux", "Add Fnu for irradiated optical star into output file. See --Topt, --starlod and --h2rcold options. Default is output for the hot disk only" )
 			( "lambda", po::value<vecd>()->multitoken()->composing(), "Wavelength to calculate Fnu, Angstrom. You can use this option multiple times. For each lambda one additional column with values of spectral flux density Fnu [erg/s/cm^2/Hz] is produced" )
 			( "passband", po::value<std::vector<std::string>>()->multitoken()->composing(), "Path of a file containing tabulated passband, the first column for wavelength in Angstrom, the second column for transmission factor, columns should be separated by spaces" )
+			( "xband", po::value<std::vector<std::string>>()->multitoken()->composing(), "Additional X-ray band as EMIN,EMAX in keV. You can use this option multiple times. Luminosities of all bands are calculated in a single pass over the disk, and columns Lx0, Fx0, Lx1, Fx1, etc. are produced for them" )
+			( "observer", po::value<std::vector<std::string>>()->multitoken()->composing(), "Additional observer of the system as INCLINATION,DISTANCE in degrees and kpc. You can use this option multiple times. The disk is evolved once and columns of Fx, Fbol and Fnu of every kind are produced for every observer with suffixes _obs1, _obs2, etc." )
 			;
 	return od;
 }
@@ -347,10 +437,47 @@ CalculationOptions::CalculationOptions(const po::variables_map &vm):
 				tauInitializer(vm),
 				vm["Nx"].as<unsigned int>(),
 				vm["gridscale"].as<std::string>(),
-				vm["starlod"].as<unsigned int>()) {
+				vm["starlod"].as<unsigned int>(),
+				default_eps,
+				vm.count("fronttracking") > 0,
+				vm["regridtol"].as<double>(),
+				vm["timescheme"].as<std::string>(),
+				vm["spacescheme"].as<std::string>(),
+				vm["Mdotquiescent"].as<double>(),
+				tauQuiescentInitializer(vm),
+				vm["selfsimilartol"].as<double>(),
+				vm["stopMdot"].as<double>(),
+				vm["stopLx"].as<double>(),
+				vm["stopRhot2Rout"].as<double>(),
+				vm["stopoutbursts"].as<unsigned int>(),
+				vm["stopwalltime"].as<double>()) {
 	if (gridscale != "log" && gridscale != "linear") {
 		throw po::invalid_option_value("Invalid --gridscale value");
 	}
+	if (regrid_tolerance < 0. || regrid_tolerance >= 1.) {
+		throw po::invalid_option_value("--regridtol should be in [0, 1)");
+	}
+	if (time_scheme != "euler" && time_scheme != "trbdf2") {
+		throw po::invalid_option_value("Invalid --timescheme value");
+	}
+	if (space_scheme != "central" && space_scheme != "compact") {
+		throw po::invalid_option_value("Invalid --spacescheme value");
+	}
+	if (Mdot_quiescent < 0.) {
+		throw po::invalid_option_value("--Mdotquiescent should not be negative");
+	}
+	if (tau_quiescent < tau) {
+		throw po::invalid_option_value("--tauquiescent should not be less than --tau");
+	}
+	if (self_similar_tolerance < 0.) {
+		throw po::invalid_option_value("--selfsimilartol should not be negative");
+	}
+	if (stop_Mdot < 0. || stop_Lx < 0. || stop_wall_time < 0.) {
+		throw po::invalid_option_value("--stopMdot, --stopLx and --stopwalltime should not be negative");
+	}
+	if (stop_Rhot_to_Rout < 0. || stop_Rhot_to_Rout >= 1.) {
+		throw po::invalid_option_value("--stopRhot2Rout should be in [0, 1)");
+	}
 }
 
 std::optional<double> CalculationOptions::tauInitializer(const po::variables_map& vm) {
@@ -360,6 +487,13 @@ std::optional<double> CalculationOptions::tauInitializer(const po::variables_map
 	return {};
 }
 
+std::optional<double> CalculationOptions::tauQuiescentInitializer(const po::variables_map& vm) {
+	if (vm.count("tauquiescent")) {
+		return dayToS(vm["tauquiescent"].as<double>());
+	}
+	return {};
+}
+
 po::options_description CalculationOptions::description() {
 	po::options_description od("Parameters of disk evolution calculation");
 	od.add_options()
@@ -369,13 +503,25 @@ po::options_description CalculationOptions::description() {
 			( "Nx",	po::value<unsigned int>()->default_value(default_Nx), "Size of calculation grid" )
 			( "gridscale", po::value<std::string>()->default_value(default_gridscale), "Type of grid for angular momentum h: log or linear" )
 			( "starlod", po::value<unsigned int>()->default_value(default_starlod), "Level of detail of the optical star 3-D model. The optical star is represented by a triangular tile, the number of tiles is 20 * 4^starlod" )
+			( "fronttracking", "Track the outer radius of the hot disk between grid points and apply the outer boundary condition there. It makes Rhot and light curves smooth for a much smaller --Nx, see --Thot" )
+			( "regridtol", po::value<double>()->default_value(default_regrid_tolerance), "Relative loss of the hot disk grid nodes which triggers redistribution of the grid nodes. Nine tenths of --Nx nodes are placed into the hot disk, more densely near its inner and outer edges. Zero means fixed grid, see --gridscale" )
+			( "timescheme", po::value<std::string>()->default_value(default_time_scheme), "Time integration scheme of the viscous evolution equation: euler is the first-order implicit Euler method, trbdf2 is the second-order L-stable TR-BDF2 method, which solves two implicit stages per step but allows several times larger --tau for the same accuracy" )
+			( "spacescheme", po::value<std::string>()->default_value(default_space_scheme), "Spatial discretisation of the viscous evolution equation: central is the second-order three-point scheme, compact is the fourth-order compact (Numerov-type) scheme, which allows several times smaller --Nx for the same accuracy. Use it with --fronttracking if --Thot is set" )
+			( "Mdotquiescent", po::value<double>()->default_value(default_Mdot_quiescent), "Accretion rate onto the central object below which the evolution is calculated with the larger time step --tauquiescent, g/s. The time step --tau is used while the accretion rate grows or the outer radius of the hot disk would cross more than one grid cell during the larger step. Zero means the constant time step --tau" )
+			( "tauquiescent", po::value<double>(), "Time step in quiescence, it is rounded to a multiple of --tau, days. Default is ten times --tau" )
+			( "selfsimilartol", po::value<double>()->default_value(default_self_similar_tolerance), "Tolerance of the switch to the self-similar decay solution F(h, t) = F(h, t0) * (1 + (t - t0) / t_s)^(-1/m). The switch happens when a numerical time step decreases F at all radii by the same factor within this fraction of its decrease, and after that F is scaled analytically at every step. Works for a disk without --Thot, --wind and --Mdotout around a black hole. Zero means numerical solution only" )
+			( "stopMdot", po::value<double>()->default_value(default_stop_Mdot), "Stop the calculation when the accretion rate onto the central object decays below this value, g/s. Zero means no limit" )
+			( "stopLx", po::value<double>()->default_value(default_stop_Lx), "Stop the calculation when the X-ray luminosity of the disk decays below this value while the accretion rate decays, erg/s. Zero means no limit" )
+			( "stopRhot2Rout", po::value<double>()->default_value(default_stop_Rhot_to_Rout), "Stop the calculation when the radius of the hot disk becomes smaller than this fraction of --rout. Zero means no limit" )
+			( "stopoutbursts", po::value<unsigned int>()->default_value(default_stop_outbursts), "Stop the calculation when the accretion rate has passed this number of maxima. Zero means no limit" )
+			( "stopwalltime", po::value<double>()->default_value(default_stop_wall_time), "Stop the calculation after this wall-clock time, seconds. Zero means no limit" )
 			;
 	return od;
 }
 
 
 
-FreddiOptions::FreddiOptions(const po::variables_map& vm) {
+FreddiOptions::FreddiOptions(const po::variables_map& vm, PassbandCache* passband_cache) {
 	if ((vm.count("starflux") > 0)
 		&& (vm.count("Mx") == 0 || vm.count("Topt") == 0 || vm.count("Mopt") == 0 || vm.count("period") == 0)) {
 		throw po::invalid_option_value("--starflux requires --Mx, --Mopt and --period to be specified");
@@ -385,7 +531,7 @@ FreddiOptions::FreddiOptions(const po::variables_map& vm) {
 	basic.reset(new BasicDiskBinaryOptions(vm));
 	disk.reset(new DiskStructureOptions(vm, *basic));
 	irr.reset(new SelfIrradiationOptions(vm, *disk));
-	flux.reset(new FluxOptions(vm));
+	flux.reset(new FluxOptions(vm, passband_cache));
 	calc.reset(new CalculationOptions(vm));
 }
 
@@ -130,6 +130,13 @@ std::string BasicFreddiFileOutput::initializeFulldataHeader(const std::vector<Fi
 	return oss.str();
 }
 
+std::string BasicFreddiFileOutput::fulldataSuffix() const {
+	if (!freddi->args().general->output_times.empty()) {
+		return std::to_string(i_dump);
+	}
+	return std::to_string(freddi->i_t());
+}
+
 void BasicFreddiFileOutput::shortDump() {
 	output.os << short_fields[0].func();
 	for (size_t i = 1; i < short_fields.size(); ++i) {
@@ -140,7 +147,7 @@ void BasicFreddiFileOutput::shortDump() {
 
 void BasicFreddiFileOutput::diskStructureDump() {
 	auto filename = (freddi->args().general->dir + "/" + freddi->args().general->prefix
-			+ "_" + std::to_string(freddi->i_t()) + ".dat");
+			+ "_" + fulldataSuffix() + ".dat");
 	std::ofstream full_output(filename);
 	full_output.precision(precision);
 
@@ -162,7 +169,7 @@ void BasicFreddiFileOutput::diskStructureDump() {
 
 void BasicFreddiFileOutput::starDump() {
 	auto filename = (freddi->args().general->dir + "/" + freddi->args().general->prefix
-					 + "_" + std::to_string(freddi->i_t()) + "_star.dat");
+					 + "_" + fulldataSuffix() + "_star.dat");
 	std::ofstream full_output(filename);
 	full_output.precision(precision);
 
@@ -189,7 +196,7 @@ void BasicFreddiFileOutput::dump() {
 			starDump();
 		}
 	}
-
+	++i_dump;
 }
 
 
@@ -198,7 +205,7 @@ std::vector<FileOutputShortField> FreddiFileOutput::initializeShortFields(const
 			{"t", "days", "Time moment", [freddi]() {return sToDay(freddi->t());}},
 			{"Mdot", "g/s", "Accretion rate onto central object",  [freddi]() {return freddi->Mdot_in();}},
 			{"Mdisk", "g", "Mass of the hot disk", [freddi]() {return freddi->Mdisk();}},
-			{"Rhot", "Rsun", "Radius of the hot disk", [freddi]() {return cmToSun(freddi->R()[freddi->last()]);}},
+			{"Rhot", "Rsun", "Radius of the hot disk", [freddi]() {return cmToSun(freddi->R_hot());}},
 			{"Sigmaout", "g/cm^2", "Surface density at the outer radius of the hot disk", [freddi]() {return freddi->Sigma()[freddi->last()];}},
 			{"Kirrout", "float", "Irradiation coefficient Kirr at the outer radius of the hot disk", [freddi]() {return freddi->Kirr()[freddi->last()];}},
 			{"H2R", "float", "Relative semiheight at the outer radius of the hot disk", [freddi]() {return freddi->Height()[freddi->last()] / freddi->R()[freddi->last()];}},
@@ -211,6 +218,21 @@ std::vector<FileOutputShortField> FreddiFileOutput::initializeShortFields(const
 			{"Fx", "erg/s/cm^2", "X-ray flux of the disk in the given energy range [emin, emax]", [freddi]() {return freddi->Lx() * freddi->angular_dist_disk(freddi->cosi()) / (FOUR_M_PI * m::pow<2>(freddi->distance()));}},
 			{"Fbol", "erg/s/cm^2", "Bolometric flux of the disk", [freddi]() {return freddi->Lbol_disk() * freddi->angular_dist_disk(freddi->cosi()) / (FOUR_M_PI * m::pow<2>(freddi->distance()));}},
 	};
+	const auto& xbands = freddi->args().flux->xbands;
+	for (size_t i_band = 0; i_band < xbands.size(); ++i_band) {
+		fields.emplace_back(
+				"Lx" + std::to_string(i_band),
+				"erg/s",
+				"X-ray luminosity of the disk" + xbandDescription(xbands[i_band]),
+				[freddi, i_band]() { return freddi->Lx_bands()[i_band]; }
+		);
+		fields.emplace_back(
+				"Fx" + std::to_string(i_band),
+				"erg/s/cm^2",
+				"X-ray flux of the disk" + xbandDescription(xbands[i_band]),
+				[freddi, i_band]() { return freddi->Lx_bands()[i_band] * freddi->angular_dist_disk(freddi->cosi()) / (FOUR_M_PI * m::pow<2>(freddi->distance())); }
+		);
+	}
 	const bool cold_disk = freddi->args().flux->cold_disk;
 	const bool star = freddi->args().flux->star;
 	const auto& lambdas = freddi->args().flux->lambdas;
@@ -220,14 +242,14 @@ std::vector<FileOutputShortField> FreddiFileOutput::initializeShortFields(const
 				std::string("Fnu") + std::to_string(i),
 				"erg/s/cm^2/Hz",
 				"Spectral flux density of the hot disk at wavelength of " + std::to_string(cmToAngstrom(lambda)) + " AA",
-				[freddi, lambda]() { return freddi->flux(lambda); }
+				[freddi, i]() { return freddi->Fnu(i); }
 		);
 		if (cold_disk) {
 			fields.emplace_back(
 					std::string("Fnu") + std::to_string(i) + "_cold",
 					"erg/s/cm^2/Hz",
 					"Spectral flux density of the cold disk at wavelength of " + std::to_string(cmToAngstrom(lambda)) + " AA",
-					[freddi, lambda]() { return freddi->flux_region<FreddiState::ColdRegion>(lambda); }
+					[freddi, i]() { return freddi->Fnu_cold(i); }
 			);
 		}
 		if (star) {
@@ -235,35 +257,39 @@ std::vector<FileOutputShortField> FreddiFileOutput::initializeShortFields(const
 					"Fnu" + std::to_string(i) + "_star",
 					"erg/s/cm^2/Hz",
 					"Spectral flux density of the optical star at wavelength of " + std::to_string(cmToAngstrom(lambda)) + " AA with respect to an orbital phase",
-					[freddi, lambda]() { return freddi->flux_star(lambda); }
+					[freddi, i]() { return freddi->Fnu_star()[0][i]; }
 			);
 			fields.emplace_back(
 					"Fnu" + std::to_string(i) + "_star_min",
 					"erg/s/cm^2/Hz",
 					"Spectral flux density of the optical star at wavelength of " + std::to_string(cmToAngstrom(lambda)) + " AA on the phase of inferior conjunction of the star",
-					[freddi, lambda]() { return freddi->flux_star(lambda, 0.0); }
+					[freddi, i]() { return freddi->Fnu_star()[1][i]; }
 			);
 			fields.emplace_back(
 					"Fnu" + std::to_string(i) + "_star_max",
 					"erg/s/cm^2/Hz",
 					"Spectral flux density of the optical star at wavelength of " + std::to_string(cmToAngstrom(lambda)) + " AA on the phase of superior conjunction of the star",
-					[freddi, lambda]() { return freddi->flux_star(lambda, M_PI); }
+					[freddi, i]() { return freddi->Fnu_star()[2][i]; }
 			);
 		}
 	}
-	for (const auto& pb : freddi->args().flux->passbands) {
+	const auto& passbands = freddi->args().flux->passbands;
+	for (size_t i_pb = 0; i_pb < passbands.size(); ++i_pb) {
+		const auto& pb = passbands[i_pb];
+		// Star fluxes of passbands follow ones of lambdas
+		const size_t i_band = lambdas.size() + i_pb;
 		fields.emplace_back(
 				"Fnu" + pb.name,
 				"erg/s/cm^2/Hz",
 				"Spectral flux density of the hot disk in passband " + pb.name,
-				[freddi, &pb]() { return freddi->flux(pb); }
+				[freddi, i_band]() { return freddi->Fnu(i_band); }
 		);
 		if (cold_disk) {
 			fields.emplace_back(
 					std::string("Fnu") + pb.name + "_cold",
 					"Spectral flux density of the cold disk in passband " + pb.name,
 					"erg/s/cm^2/Hz",
-					[freddi, &pb]() { return freddi->flux_region<FreddiState::ColdRegion>(pb); }
+					[freddi, i_band]() { return freddi->Fnu_cold(i_band); }
 			);
 		}
 		if (star) {
@@ -271,25 +297,112 @@ std::vector<FileOutputShortField> FreddiFileOutput::initializeShortFields(const
 					"Fnu" + pb.name + "_star",
 					"erg/s/cm^2/Hz",
 					"Spectral flux density of the optical star in passband " + pb.name + " with respect to an orbital phase",
-					[freddi, &pb]() { return freddi->flux_star(pb); }
+					[freddi, i_band]() { return freddi->Fnu_star()[0][i_band]; }
 			);
 			fields.emplace_back(
 					"Fnu" + pb.name + "_star_min",
 					"erg/s/cm^2/Hz",
 					"Spectral flux density of the optical star in passband " + pb.name + " on the phase of inferior conjunction of the star",
-					[freddi, &pb]() { return freddi->flux_star(pb, 0.0); }
+					[freddi, i_band]() { return freddi->Fnu_star()[1][i_band]; }
 			);
 			fields.emplace_back(
 					"Fnu" + pb.name + "_star_max",
 					"erg/s/cm^2/Hz",
 					"Spectral flux density of the optical star in passband " + pb.name + " on the phase of superior conjunction of the star",
-					[freddi, &pb]() { return freddi->flux_star(pb, M_PI); }
+					[freddi, i_band]() { return freddi->Fnu_star()[2][i_band]; }
 			);
 		}
 	}
+	const auto& observers = freddi->observers();
+	for (size_t i_obs = 0; i_obs < observers.size(); ++i_obs) {
+		const auto suffix = observerSuffix(i_obs);
+		const auto for_observer = observerDescription(observers[i_obs]);
+		fields.emplace_back(
+				"Fx" + suffix,
+				"erg/s/cm^2",
+				"X-ray flux of the disk in the given energy range [emin, emax]" + for_observer,
+				[freddi, i_obs]() { const auto& obs = freddi->observers()[i_obs]; return freddi->Lx() * freddi->angular_dist_disk(obs.cosi) / (FOUR_M_PI * m::pow<2>(obs.distance)); }
+		);
+		fields.emplace_back(
+				"Fbol" + suffix,
+				"erg/s/cm^2",
+				"Bolometric flux of the disk" + for_observer,
+				[freddi, i_obs]() { const auto& obs = freddi->observers()[i_obs]; return freddi->Lbol_disk() * freddi->angular_dist_disk(obs.cosi) / (FOUR_M_PI * m::pow<2>(obs.distance)); }
+		);
+		for (size_t i_band = 0; i_band < xbands.size(); ++i_band) {
+			fields.emplace_back(
+					"Fx" + std::to_string(i_band) + suffix,
+					"erg/s/cm^2",
+					"X-ray flux of the disk" + xbandDescription(xbands[i_band]) + for_observer,
+					[freddi, i_obs, i_band]() { const auto& obs = freddi->observers()[i_obs]; return freddi->Lx_bands()[i_band] * freddi->angular_dist_disk(obs.cosi) / (FOUR_M_PI * m::pow<2>(obs.distance)); }
+			);
+		}
+		// Bands of lambdas go first, passbands follow them
+		std::vector<std::string> band_names, band_descriptions;
+		for (size_t i = 0; i < lambdas.size(); ++i) {
+			band_names.push_back(std::to_string(i));
+			band_descriptions.push_back("at wavelength of " + std::to_string(cmToAngstrom(lambdas[i])) + " AA");
+		}
+		for (const auto& pb : passbands) {
+			band_names.push_back(pb.name);
+			band_descriptions.push_back("in passband " + pb.name);
+		}
+		for (size_t i_band = 0; i_band < band_names.size(); ++i_band) {
+			fields.emplace_back(
+					"Fnu" + band_names[i_band] + suffix,
+					"erg/s/cm^2/Hz",
+					"Spectral flux density of the hot disk " + band_descriptions[i_band] + for_observer,
+					[freddi, i_obs, i_band]() { return freddi->Fnu_observer(i_obs, i_band); }
+			);
+			if (cold_disk) {
+				fields.emplace_back(
+						"Fnu" + band_names[i_band] + "_cold" + suffix,
+						"erg/s/cm^2/Hz",
+						"Spectral flux density of the cold disk " + band_descriptions[i_band] + for_observer,
+						[freddi, i_obs, i_band]() { return freddi->Fnu_cold_observer(i_obs, i_band); }
+				);
+			}
+			if (star) {
+				fields.emplace_back(
+						"Fnu" + band_names[i_band] + "_star" + suffix,
+						"erg/s/cm^2/Hz",
+						"Spectral flux density of the optical star " + band_descriptions[i_band] + " with respect to an orbital phase" + for_observer,
+						[freddi, i_obs, i_band]() { return freddi->Fnu_star_observer(i_obs)[0][i_band]; }
+				);
+				fields.emplace_back(
+						"Fnu" + band_names[i_band] + "_star_min" + suffix,
+						"erg/s/cm^2/Hz",
+						"Spectral flux density of the optical star " + band_descriptions[i_band] + " on the phase of inferior conjunction of the star" + for_observer,
+						[freddi, i_obs, i_band]() { return freddi->Fnu_star_observer(i_obs)[1][i_band]; }
+				);
+				fields.emplace_back(
+						"Fnu" + band_names[i_band] + "_star_max" + suffix,
+						"erg/s/cm^2/Hz",
+						"Spectral flux density of the optical star " + band_descriptions[i_band] + " on the phase of superior conjunction of the star" + for_observer,
+						[freddi, i_obs, i_band]() { return freddi->Fnu_star_observer(i_obs)[2][i_band]; }
+				);
+			}
+		}
+	}
 	return fields;
 }
 
+std::string FreddiFileOutput::observerSuffix(const size_t i_obs) {
+	return "_obs" + std::to_string(i_obs + 1);
+}
+
+std::string FreddiFileOutput::xbandDescription(const EnergyBand& band) {
+	std::ostringstream os;
+	os << " in the energy range [" << hertzToKev(band.emin) << ", " << hertzToKev(band.emax) << "] keV";
+	return os.str();
+}
+
+std::string FreddiFileOutput::observerDescription(const FreddiState::ObserverGeometry& observer) {
+	std::ostringstream os;
+	os << " for the observer with inclination " << observer.inclination / M_PI * 180.0 << " degrees at distance " << cmToKpc(observer.distance) << " kpc";
+	return os.str();
+}
+
 std::vector<FileOutputLongField> FreddiFileOutput::initializeDiskStructureFields(const std::shared_ptr<FreddiEvolution>& freddi) {
 	return {
 			{"h", "cm^2/s", "Keplerian specific angular momentum", [freddi](size_t i) {return freddi->h()[i];}},
@@ -65,3 +65,13 @@ double Passband::bb_integral(const double temp) const {
 			0,
 			data.size() - 1);
 }
+
+
+Passband PassbandCache::get(const std::string& filepath) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = passbands.find(filepath);
+	if (it == passbands.end()) {
+		it = passbands.emplace(filepath, Passband(filepath)).first;
+	}
+	return it->second;
+}
@@ -112,8 +112,9 @@ double DimensionlessRocheLobe::r(const double lambda, const double nu) const {
 }
 
 double DimensionlessRocheLobe::r(const Vec3& vec) const {
-	const double lambda = -vec.x() / vec.length();
-	const double nu = vec.z() / vec.length();
+	const double length = vec.length();
+	const double lambda = -vec.x() / length;
+	const double nu = vec.z() / length;
 	return r(lambda, nu);
 }
 
@@ -0,0 +1,207 @@
+#include "server.hpp"
+
+#include <cmath>  // isfinite
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+namespace pt = boost::property_tree;
+
+
+ServerConnection::ServerConnection(const int input_fd, const int output_fd, const bool owns_fds):
+		input(owns_fds ? fdopen(input_fd, "r") : stdin),
+		output_fd(output_fd),
+		owns_fds(owns_fds) {
+	if (input == nullptr) {
+		throw std::runtime_error(std::string("Cannot open connection: ") + std::strerror(errno));
+	}
+}
+
+ServerConnection::~ServerConnection() {
+	if (!owns_fds) {
+		return;
+	}
+	// input is freed by fclose(), and output_fd can be reused by another connection right after it is closed
+	const bool shared_fd = output_fd == fileno(input);
+	fclose(input);
+	if (!shared_fd) {
+		close(output_fd);
+	}
+}
+
+bool ServerConnection::readLine(std::string& line) {
+	line.clear();
+	for (int c = fgetc(input); c != EOF; c = fgetc(input)) {
+		if (c == '\n') {
+			return true;
+		}
+		line.push_back(static_cast<char>(c));
+	}
+	return !line.empty();
+}
+
+void ServerConnection::writeLine(const std::string& line) {
+	const std::string buffer = line + "\n";
+	std::lock_guard<std::mutex> lock(write_mutex);
+	for (size_t written = 0; written < buffer.size(); ) {
+		const ssize_t n = write(output_fd, buffer.data() + written, buffer.size() - written);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return;
+		}
+		written += n;
+	}
+}
+
+
+WorkerPool::WorkerPool(unsigned int n_threads) {
+	if (n_threads == 0) {
+		n_threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	for (unsigned int i = 0; i < n_threads; ++i) {
+		threads.emplace_back(&WorkerPool::work, this);
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	condition.notify_all();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+void WorkerPool::submit(std::function<void ()>&& task) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push(std::move(task));
+	}
+	condition.notify_one();
+}
+
+void WorkerPool::work() {
+	for (;;) {
+		std::function<void ()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+			if (tasks.empty()) {
+				return;
+			}
+			task = std::move(tasks.front());
+			tasks.pop();
+		}
+		task();
+	}
+}
+
+
+ServerRequest ServerRequest::fromJson(const std::string& line, const std::string& default_id) {
+	pt::ptree tree;
+	std::istringstream stream(line);
+	pt::read_json(stream, tree);
+
+	// get_child() returns a reference to its default value
+	const pt::ptree empty;
+	ServerRequest request;
+	request.id = tree.get<std::string>("id", default_id);
+	for (const auto& option : tree.get_child("options", empty)) {
+		const std::string& name = option.first;
+		if (option.second.empty()) {
+			const std::string& value = option.second.data();
+			if (value == "true") {
+				request.args.push_back("--" + name);
+			} else if (value != "false") {
+				request.args.push_back("--" + name + "=" + value);
+			}
+			continue;
+		}
+		for (const auto& item : option.second) {
+			if (!item.first.empty() || !item.second.empty()) {
+				throw std::invalid_argument("Value of option " + name + " should be a number, a string or an array of them");
+			}
+			request.args.push_back("--" + name + "=" + item.second.data());
+		}
+	}
+	for (const auto& item : tree.get_child("times", empty)) {
+		request.times.push_back(item.second.get_value<double>());
+	}
+	for (const auto& item : tree.get_child("columns", empty)) {
+		request.columns.push_back(item.second.data());
+	}
+	return request;
+}
+
+
+std::string jsonString(const std::string& s) {
+	std::ostringstream os;
+	os << '"';
+	for (const char c : s) {
+		switch (c) {
+			case '"': os << "\\\""; break;
+			case '\\': os << "\\\\"; break;
+			case '\n': os << "\\n"; break;
+			case '\t': os << "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					const char* hex = "0123456789abcdef";
+					os << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+				} else {
+					os << c;
+				}
+		}
+	}
+	os << '"';
+	return os.str();
+}
+
+std::string jsonNumber(const double x, const unsigned short precision) {
+	// JSON has no infinities and NaNs
+	if (!std::isfinite(x)) {
+		return "null";
+	}
+	std::ostringstream os;
+	os.precision(precision);
+	os << x;
+	return os.str();
+}
+
+std::string jsonError(const std::string& id, const std::string& what) {
+	return "{\"id\": " + jsonString(id) + ", \"error\": " + jsonString(what) + "}";
+}
+
+
+int listenUnixSocket(const std::string& path) {
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path)) {
+		throw std::runtime_error("Socket path is too long: " + path);
+	}
+	path.copy(address.sun_path, path.size());
+
+	struct stat path_stat;
+	if (stat(path.c_str(), &path_stat) == 0 && S_ISSOCK(path_stat.st_mode)) {
+		unlink(path.c_str());
+	}
+	const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		throw std::runtime_error(std::string("Cannot create socket: ") + std::strerror(errno));
+	}
+	if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+			|| listen(fd, SOMAXCONN) < 0) {
+		const std::string error = std::strerror(errno);
+		close(fd);
+		throw std::runtime_error("Cannot listen on socket " + path + ": " + error);
+	}
+	return fd;
+}
@@ -1,6 +1,8 @@
 #include "orbit.hpp"
 #include "spectrum.hpp"
 
+#include <algorithm>  // fill lower_bound sort unique
+
 #include <boost/numeric/odeint.hpp>
 
 namespace odeint = boost::numeric::odeint;
@@ -23,6 +25,39 @@ double Planck_lambda(const double T, const double lambda) {
 }
 
 
+void disk_radial_Planck_lambda(const vecd& r, const vecd& T, const size_t first, const size_t last, const vecd& lambdas, vecd& I) {
+	const size_t n = lambdas.size();
+	I.assign(n, 0.);
+	if (first >= last) {
+		return;
+	}
+	// exp(x) is infinite and B_lambda is zero for larger x
+	const double max_exponent = std::log(std::numeric_limits<double>::max());
+	vecd ch_over_kB_lambda(n);
+	for (size_t j = 0; j < n; ++j) {
+		ch_over_kB_lambda[j] = ch_over_kB / lambdas[j];
+	}
+	for (size_t i = first; i <= last; ++i) {
+		if (!(T[i] > 0.)) {  // catches NaN
+			continue;
+		}
+		const double dr = (i == first) ? r[first + 1] - r[first] : ((i == last) ? r[last] - r[last - 1] : r[i + 1] - r[i - 1]);
+		// 0.5 is trapezoid rule factor
+		const double weight = M_PI * r[i] * dr;
+		const double inverse_T = 1. / T[i];
+		for (size_t j = 0; j < n; ++j) {
+			const double x = ch_over_kB_lambda[j] * inverse_T;
+			if (x < max_exponent) {
+				I[j] += weight / (std::exp(x) - 1.);
+			}
+		}
+	}
+	for (size_t j = 0; j < n; ++j) {
+		I[j] *= double_h_c2 / m::pow<5>(lambdas[j]);
+	}
+}
+
+
 double Planck_nu1_nu2(const double T, const double nu1, const double nu2, const double tol){
 	auto stepper = odeint::runge_kutta_cash_karp54<double>();
 	double integral = 0.;
@@ -37,11 +72,65 @@ double Planck_nu1_nu2(const double T, const double nu1, const double nu2, const
 }
 
 
+FrequencyBands::FrequencyBands(const vecd& nu1, const vecd& nu2) {
+	edges_ = nu1;
+	edges_.insert(edges_.end(), nu2.begin(), nu2.end());
+	std::sort(edges_.begin(), edges_.end());
+	edges_.erase(std::unique(edges_.begin(), edges_.end()), edges_.end());
+	needed_.assign(edges_.empty() ? 0 : edges_.size() - 1, false);
+	for (size_t j = 0; j < nu1.size(); ++j) {
+		first_.push_back(std::lower_bound(edges_.begin(), edges_.end(), nu1[j]) - edges_.begin());
+		last_.push_back(std::lower_bound(edges_.begin(), edges_.end(), nu2[j]) - edges_.begin());
+		std::fill(needed_.begin() + first_[j], needed_.begin() + last_[j], true);
+	}
+}
+
+
+void FrequencyBands::Planck_nu1_nu2(const double T, vecd& integrals, const double tol, const double nu_divider) const {
+	// Every segment is added to the bands it belongs to right away, so no per-call buffer of segments is needed and
+	// integrals keeps its capacity between calls
+	integrals.assign(size(), 0.);
+	for (size_t k = 0; k < needed_.size(); ++k) {
+		if (!needed_[k]) {
+			continue;
+		}
+		const double segment = Spectrum::Planck_nu1_nu2(T, edges_[k] / nu_divider, edges_[k + 1] / nu_divider, tol);
+		for (size_t j = 0; j < size(); ++j) {
+			if (first_[j] <= k && k < last_[j]) {
+				integrals[j] += segment;
+			}
+		}
+	}
+}
+
+
+void disk_radial_Planck_nu1_nu2(const vecd& r, const vecd& T, const size_t first, const size_t last, const FrequencyBands& bands, vecd& I, const double tol) {
+	const size_t n = bands.size();
+	I.assign(n, 0.);
+	if (first >= last) {
+		return;
+	}
+	vecd integrals;
+	for (size_t i = first; i <= last; ++i) {
+		if (!(T[i] > 0.)) {  // catches NaN
+			continue;
+		}
+		const double dr = (i == first) ? r[first + 1] - r[first] : ((i == last) ? r[last] - r[last - 1] : r[i + 1] - r[i - 1]);
+		// 0.5 is trapezoid rule factor
+		const double weight = M_PI * r[i] * dr;
+		bands.Planck_nu1_nu2(T[i], integrals, tol);
+		for (size_t j = 0; j < n; ++j) {
+			I[j] += weight * integrals[j];
+		}
+	}
+}
+
+
 // Code by Galina Lipunova:
 /* General Relativity effects are included in the structure of the disk
    (Page & Thorne 1974; Riffert & Herold 1995). metric = "GR"
 */
-double T_GR(const double r1, const double ak, const double Mx, const double Mdot){
+double Qvis_GR_over_Mdot(const double r1, const double ak, const double Mx){
 	const double GM = GSL_CONST_CGSM_GRAVITATIONAL_CONSTANT * Mx;
 	const double rg = GM  / m::pow<2>(GSL_CONST_CGSM_SPEED_OF_LIGHT);
 	const double x = std::sqrt(r1 / rg);
@@ -58,12 +147,12 @@ double T_GR(const double r1, const double ak, const double Mx, const double Mdot
 	const double b = 3. * (x2-ak)*(x2-ak) * std::log((x-x2)/(x0-x2))/x2/(x2-x1)/(x2-x3);
 	const double c = 3. * (x3-ak)*(x3-ak) * std::log((x-x3)/(x0-x3))/x3/(x3-x1)/(x3-x2);
 
-	return( std::pow(
-			(3.*Mdot * m::pow<6>(GSL_CONST_CGSM_SPEED_OF_LIGHT) / (8.*M_PI * m::pow<2>(GM))) *
-			(x - x0 - 1.5 * ak * std::log(x/x0) - a - b -c) / ( m::pow<4>(x)*(m::pow<3>(x) - 3.*x + 2. * ak) ) /
-			GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT,
-			0.25)
+	return (3. * m::pow<6>(GSL_CONST_CGSM_SPEED_OF_LIGHT) / (8.*M_PI * m::pow<2>(GM))) *
+			(x - x0 - 1.5 * ak * std::log(x/x0) - a - b -c) / ( m::pow<4>(x)*(m::pow<3>(x) - 3.*x + 2. * ak) );
+}
+
 
-	);
+double T_GR(const double r1, const double ak, const double Mx, const double Mdot){
+	return std::pow(Mdot * Qvis_GR_over_Mdot(r1, ak, Mx) / GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT, 0.25);
 }
 } // namespace Spectrum
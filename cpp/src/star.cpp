@@ -1,3 +1,4 @@
+#include <cmath> // sqrt
 #include <numeric> // accumulate
 
 #include <constants.hpp>
@@ -27,6 +28,7 @@ std::vector<Triangle> Star::initializeSphereTriangles(const double radius, const
 std::vector<Triangle> Star::initializeRocheTriangles(const RocheLobe& roche_lobe, const unsigned short grid_scale) {
 	const auto sphere_triangles = unit_sphere_triangles(grid_scale);
 	std::vector<Triangle> triangles;
+	triangles.reserve(sphere_triangles.size());
 	for (const auto& sph_tr : sphere_triangles) {
 		auto vertices = sph_tr.vertices();
 		for (auto& vertex : vertices) {
@@ -49,22 +51,6 @@ const vald& Star::Tth() const {
 	return Tth_;
 }
 
-double Star::integrate(std::function<double (size_t)>&& func) const {
-	double sum = 0;
-	for (size_t i = 0; i < triangles().size(); ++i) {
-		sum += triangles()[i].area() * func(i);
-	}
-	return sum;
-}
-
-double Star::integrate(std::function<double (size_t)>&& func, const UnitVec3& direction) const {
-	double sum = 0;
-	for (size_t i = 0; i < triangles().size(); ++i) {
-		sum += triangles()[i].area_cos(direction) * func(i);
-	}
-	return sum;
-}
-
 const vald& Star::Qirr() {
 	if (!irr_.Qirr) {
 		irr_.Qirr = vald(0.0, triangles().size());
@@ -81,16 +67,18 @@ const vald& Star::Teff() {
 
 double Star::luminosity() {
 	if (!irr_.luminosity) {
-		irr_.luminosity = integrate([this](size_t i) -> double {
-			return GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT * m::pow<4>(Teff()[i]);
+		const vald& T = Teff();
+		irr_.luminosity = integrate([&T](size_t i) -> double {
+			return GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT * m::pow<4>(T[i]);
 		});
 	}
 	return *irr_.luminosity;
 }
 
 double Star::luminosity(const UnitVec3& direction) {
-	const double integral = integrate([this](size_t i) -> double {
-			return m::pow<4>(Teff()[i]);
+	const vald& T = Teff();
+	const double integral = integrate([&T](size_t i) -> double {
+			return m::pow<4>(T[i]);
 		}, direction);
 	// 4 = 4 pi / pi; 1/pi = intensity / flux
 	return 4.0 * GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT * integral;
@@ -101,17 +89,59 @@ double Star::luminosity(const UnitVec3& direction) {
 // "luminosity in direction" / (4 \pi d^2)
 
 double Star::luminosity(const UnitVec3& direction, double lambda) {
-	return integrate([this, lambda](size_t i) -> double {
-			return Spectrum::Planck_lambda(Teff()[i], lambda) * m::pow<2>(lambda) / GSL_CONST_CGSM_SPEED_OF_LIGHT;
+	const vald& T = Teff();
+	return integrate([&T, lambda](size_t i) -> double {
+			return Spectrum::Planck_lambda(T[i], lambda) * m::pow<2>(lambda) / GSL_CONST_CGSM_SPEED_OF_LIGHT;
 		},
 			direction) * FOUR_M_PI;
 }
 
 double Star::luminosity(const UnitVec3& direction, const Passband& passband) {
-	return integrate([this, &passband](size_t i) -> double { return passband.bb_nu(Teff()[i]); },
+	const vald& T = Teff();
+	return integrate([&T, &passband](size_t i) -> double { return passband.bb_nu(T[i]); },
 			direction) * FOUR_M_PI;
 }
 
+std::vector<vecd> Star::luminosities(const std::vector<UnitVec3>& directions, const vecd& lambdas, const std::vector<Passband>& passbands) {
+	const size_t n_bands = lambdas.size() + passbands.size();
+	std::vector<vecd> lum(directions.size(), vecd(n_bands, 0.0));
+	vecd area_cos(directions.size());
+	vecd band_lum(n_bands);
+	const vald& T = Teff();
+	for (size_t i = 0; i < triangles().size(); ++i) {
+		bool visible = false;
+		for (size_t i_dir = 0; i_dir < directions.size(); ++i_dir) {
+			area_cos[i_dir] = triangles()[i].area_cos(directions[i_dir]);
+			visible = visible || (area_cos[i_dir] > 0.0);
+		}
+		// Planck function is calculated for triangles visible from at least one direction only
+		if (!visible) {
+			continue;
+		}
+		for (size_t i_lambda = 0; i_lambda < lambdas.size(); ++i_lambda) {
+			const double lambda = lambdas[i_lambda];
+			band_lum[i_lambda] = Spectrum::Planck_lambda(T[i], lambda) * m::pow<2>(lambda) / GSL_CONST_CGSM_SPEED_OF_LIGHT;
+		}
+		for (size_t i_pb = 0; i_pb < passbands.size(); ++i_pb) {
+			band_lum[lambdas.size() + i_pb] = passbands[i_pb].bb_nu(T[i]);
+		}
+		for (size_t i_dir = 0; i_dir < directions.size(); ++i_dir) {
+			if (area_cos[i_dir] == 0.0) {
+				continue;
+			}
+			for (size_t i_band = 0; i_band < n_bands; ++i_band) {
+				lum[i_dir][i_band] += area_cos[i_dir] * band_lum[i_band];
+			}
+		}
+	}
+	for (auto& lum_dir : lum) {
+		for (auto& x : lum_dir) {
+			x *= FOUR_M_PI;
+		}
+	}
+	return lum;
+}
+
 IrrSource::~IrrSource()	{}
 
 double IrrSource::cos_object(const UnitVec3& direction, const UnitVec3& normal) {
@@ -131,12 +161,13 @@ PointLikeSource::~PointLikeSource() {}
 
 double PointLikeSource::irr_flux(const Vec3& coord, const UnitVec3& normal) const {
 	const auto distance = coord - position();
-	const UnitVec3 direction(distance);
+	const double distance2 = distance.squaredLength();
+	const UnitVec3 direction(distance, std::sqrt(distance2));
 	if (shadow(direction)) {
 		return 0;
 	}
 	const double cos_obj = cos_object(direction, normal);
-	return irr_luminosity(direction) * (1.0 - albedo(cos_obj)) / (FOUR_M_PI * m::pow<2>(distance.length())) * cos_obj;
+	return irr_luminosity(direction) * (1.0 - albedo(cos_obj)) / (FOUR_M_PI * distance2) * cos_obj;
 }
 
 const Vec3& PointLikeSource::position() const {
@@ -0,0 +1,206 @@
+#include "sweep.hpp"
+
+#include <algorithm>  // replace_if
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+#include <boost/algorithm/string.hpp> // split is_any_of
+
+
+SweepOptions::SweepOptions(const po::variables_map& vm):
+		list(vm.count("list") > 0 ? vm["list"].as<std::string>() : ""),
+		grid(gridInitializer(vm)),
+		columns(columnsInitializer(vm)),
+		prefix(vm["prefix"].as<std::string>()),
+		dir(vm["dir"].as<std::string>()),
+		output_precision(vm["precision"].as<unsigned int>()) {
+	if (!list.empty() && !grid.empty()) {
+		throw po::error("--list and --grid cannot be used together");
+	}
+	if (list.empty() && grid.empty()) {
+		throw po::error("--list or --grid should be specified");
+	}
+}
+
+SweepOptions::Grid SweepOptions::gridInitializer(const po::variables_map& vm) {
+	if (vm.count("grid") == 0) {
+		return {};
+	}
+	Grid grid;
+	for (const auto& item : vm["grid"].as<std::vector<std::string>>()) {
+		const size_t eq = item.find('=');
+		if (eq == std::string::npos || eq == 0 || eq + 1 == item.size()) {
+			throw po::invalid_option_value(item);
+		}
+		const std::string name = item.substr(0, eq);
+		const std::string values_str = item.substr(eq + 1);
+		std::vector<std::string> values;
+		if (values_str.find(':') == std::string::npos) {
+			boost::split(values, values_str, boost::is_any_of(","));
+		} else {
+			// FIRST:LAST:N or FIRST:LAST:N:log
+			std::vector<std::string> tokens;
+			boost::split(tokens, values_str, boost::is_any_of(":"));
+			if (tokens.size() < 3 || tokens.size() > 4 || (tokens.size() == 4 && tokens[3] != "log")) {
+				throw po::invalid_option_value(item);
+			}
+			double first, last;
+			unsigned long n;
+			try {
+				first = std::stod(tokens[0]);
+				last = std::stod(tokens[1]);
+				n = std::stoul(tokens[2]);
+			} catch (const std::logic_error&) {
+				throw po::invalid_option_value(item);
+			}
+			const bool log = tokens.size() == 4;
+			if (n == 0 || (log && (first <= 0. || last <= 0.))) {
+				throw po::invalid_option_value(item);
+			}
+			for (unsigned long i = 0; i < n; ++i) {
+				const double x = n == 1 ? 0. : static_cast<double>(i) / (n - 1);
+				std::ostringstream value;
+				value << std::setprecision(15) << (log ? first * std::pow(last / first, x) : first + (last - first) * x);
+				values.push_back(value.str());
+			}
+		}
+		if (std::any_of(values.begin(), values.end(), [](const std::string& value) { return value.empty(); })) {
+			throw po::invalid_option_value(item);
+		}
+		grid.emplace_back(name, values);
+	}
+	return grid;
+}
+
+std::vector<std::string> SweepOptions::columnsInitializer(const po::variables_map& vm) {
+	if (vm.count("columns") == 0) {
+		return {};
+	}
+	std::vector<std::string> columns;
+	boost::split(columns, vm["columns"].as<std::string>(), boost::is_any_of(","));
+	return columns;
+}
+
+po::options_description SweepOptions::description() {
+	po::options_description od("Sweep options");
+	od.add_options()
+			( "list", po::value<std::string>(), "Path of a file with a parameter set per line in the format of --serve mode, e.g. {\"id\": \"run1\", \"options\": {\"alpha\": 0.3}, \"times\": [1, 2.5], \"columns\": [\"t\", \"Mdot\"]}. Options of parameter sets override the command line and configuration files" )
+			( "grid", po::value<std::vector<std::string>>()->multitoken()->composing(), "Option and its values to calculate all their combinations with values of other --grid options: --grid alpha=0.1,0.2,0.4 for a list of values, --grid Mx=5:15:11 for evenly spaced values from 5 to 15, or --grid F0=1e37:1e39:21:log for logarithmically spaced values. Values of --grid override the command line and configuration files, --grid cannot be used with --list" )
+			( "columns", po::value<std::string>(), "Comma-separated names of PREFIX.dat columns to output for parameter sets which don't set them, default is all columns" )
+			;
+	return od;
+}
+
+
+SweepParameterSets::SweepParameterSets(const SweepOptions& sweep):
+		grid(sweep.grid) {
+	if (!sweep.list.empty()) {
+		list.open(sweep.list);
+		if (!list) {
+			throw po::invalid_option_value("List file doesn't exist");
+		}
+		return;
+	}
+	grid_size = 1;
+	for (const auto& option : grid) {
+		grid_size *= option.second.size();
+	}
+}
+
+bool SweepParameterSets::next(std::string& line) {
+	if (list.is_open()) {
+		while (std::getline(list, line)) {
+			if (line.find_first_not_of(" \t\r") != std::string::npos) {
+				++count;
+				return true;
+			}
+		}
+		return false;
+	}
+	if (count >= grid_size) {
+		return false;
+	}
+	std::vector<std::string> values(grid.size());
+	size_t index = count;
+	for (size_t i = grid.size(); i-- > 0; ) {
+		const auto& option_values = grid[i].second;
+		values[i] = option_values[index % option_values.size()];
+		index /= option_values.size();
+	}
+	std::string id;
+	std::string options;
+	for (size_t i = 0; i < grid.size(); ++i) {
+		id += (i > 0 ? " " : "") + grid[i].first + "=" + values[i];
+		options += (i > 0 ? ", " : "") + jsonString(grid[i].first) + ": " + jsonString(values[i]);
+	}
+	line = "{\"id\": " + jsonString(id) + ", \"options\": {" + options + "}}";
+	++count;
+	return true;
+}
+
+
+std::string sweepResultHeader(const size_t model, const std::string& id, const std::string& status, const std::string& message) {
+	const auto single_field = [](std::string s) {
+		std::replace_if(s.begin(), s.end(), [](const char c) { return c == '\t' || c == '\n'; }, ' ');
+		return s;
+	};
+	return std::to_string(model) + "\t" + single_field(id) + "\t" + status + "\t" + single_field(message) + "\n";
+}
+
+
+SweepStore::SweepStore(const SweepOptions& sweep):
+		output(sweep.dir + "/" + sweep.prefix + ".dat"),
+		status(sweep.dir + "/" + sweep.prefix + "_status.dat") {
+	if (!output || !status) {
+		throw std::runtime_error("Cannot open output files in " + sweep.dir);
+	}
+	status << "#model\tid\tstatus\tmessage\n";
+}
+
+void SweepStore::write(const std::string& result) {
+	std::istringstream lines(result);
+	std::string header;
+	std::getline(lines, header);
+	std::vector<std::string> fields;
+	boost::split(fields, header, boost::is_any_of("\t"));
+	if (fields.size() != 4) {
+		throw std::invalid_argument("Wrong sweep result: " + header);
+	}
+	const std::string& model = fields[0];
+	std::string status_name = fields[2];
+	std::string message = fields[3];
+
+	if (status_name != "error") {
+		std::string result_names, units, descriptions;
+		std::getline(lines, result_names);
+		std::getline(lines, units);
+		std::getline(lines, descriptions);
+		if (names.empty()) {
+			names = result_names;
+			output << "#model\t" << names << "\n";
+			output << "#\t" << units << "\n";
+			output << "### Columns description\n";
+			output << "# 1=model [] : Number of the parameter set, see PREFIX_status.dat\n";
+			std::vector<std::string> name_list, unit_list, description_list;
+			boost::split(name_list, names, boost::is_any_of("\t"));
+			boost::split(unit_list, units, boost::is_any_of("\t"));
+			boost::split(description_list, descriptions, boost::is_any_of("\t"));
+			for (size_t i = 0; i < name_list.size(); ++i) {
+				output << "# " << i + 2 << "=" << name_list[i] << " [" << unit_list.at(i) << "] : " << description_list.at(i) << "\n";
+			}
+		}
+		if (result_names == names) {
+			for (std::string row; std::getline(lines, row); ) {
+				output << model << "\t" << row << "\n";
+			}
+		} else {
+			status_name = "error";
+			message = "Columns differ from the columns of the first parameter set";
+		}
+	}
+	if (status_name == "error") {
+		++failed_;
+	}
+	status << model << "\t" << fields[1] << "\t" << status_name << "\t" << message << "\n";
+}
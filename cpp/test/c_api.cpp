@@ -0,0 +1,177 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <freddi_c_api.h>
+#include <unit_transformation.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_c_api
+
+#include <boost/test/unit_test.hpp>
+
+
+std::vector<std::string> get_args(const double alpha) {
+	return {"--Mx=5", "--Mopt=0.5", "--period=0.2315", "--F0=2e38", "--initialcond=powerF", "--powerorder=6",
+			"--alpha=" + std::to_string(alpha), "--distance=1", "--time=20", "--tau=0.25", "--Nx=100"};
+}
+
+std::vector<const char*> get_argv(const std::vector<std::string>& args) {
+	std::vector<const char*> argv;
+	for (const auto& arg : args) {
+		argv.push_back(arg.c_str());
+	}
+	return argv;
+}
+
+
+BOOST_AUTO_TEST_CASE(testCreate_wrong_options) {
+	const std::vector<const char*> argv = {"--Mx=5", "--unknownoption=1"};
+	BOOST_CHECK(freddi_create(argv.size(), argv.data(), 0) == nullptr);
+	BOOST_CHECK(!std::string(freddi_last_error()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(testStep_vs_evolve_to) {
+	const auto args = get_args(0.25);
+	const auto argv = get_argv(args);
+	freddi_model* stepped = freddi_create(argv.size(), argv.data(), 0);
+	freddi_model* evolved = freddi_create(argv.size(), argv.data(), 0);
+	BOOST_REQUIRE(stepped != nullptr);
+	BOOST_REQUIRE(evolved != nullptr);
+	BOOST_CHECK_EQUAL(freddi_Nx(stepped), 100);
+
+	const std::vector<const char*> names = {"t", "Mdot", "Lx"};
+	std::vector<double> stepped_values(names.size()), evolved_values(names.size());
+	std::vector<double> stepped_F(freddi_Nx(stepped)), evolved_F(freddi_Nx(evolved));
+	size_t steps = 0;
+	while (freddi_step(stepped) == 1) {
+		++steps;
+		BOOST_REQUIRE_EQUAL(freddi_evolve_to(evolved, freddi_time(stepped)), 1);
+		BOOST_REQUIRE_EQUAL(freddi_scalars(stepped, names.size(), names.data(), stepped_values.data()), 0);
+		BOOST_REQUIRE_EQUAL(freddi_scalars(evolved, names.size(), names.data(), evolved_values.data()), 0);
+		BOOST_CHECK_CLOSE_FRACTION(stepped_values[0], sToDay(freddi_time(stepped)), 1e-12);
+		for (size_t i = 0; i < names.size(); ++i) {
+			BOOST_CHECK_CLOSE_FRACTION(stepped_values[i], evolved_values[i], 1e-10);
+		}
+		BOOST_REQUIRE_EQUAL(freddi_field(stepped, "F", stepped_F.data(), stepped_F.size()), 0);
+		BOOST_REQUIRE_EQUAL(freddi_field(evolved, "F", evolved_F.data(), evolved_F.size()), 0);
+		for (size_t i = freddi_first(stepped); i <= freddi_last(stepped); ++i) {
+			BOOST_CHECK_CLOSE_FRACTION(stepped_F[i], evolved_F[i], 1e-10);
+		}
+	}
+	BOOST_CHECK_EQUAL(steps, 80);
+	BOOST_CHECK_EQUAL(freddi_i_t(stepped), 80);
+
+	const char* unknown = "unknown";
+	double value;
+	BOOST_CHECK_EQUAL(freddi_scalars(stepped, 1, &unknown, &value), -1);
+	BOOST_CHECK_EQUAL(freddi_field(stepped, "R", stepped_F.data(), 10), -1);
+
+	freddi_destroy(stepped);
+	freddi_destroy(evolved);
+}
+
+BOOST_AUTO_TEST_CASE(testStep_after_evolve_to) {
+	const auto args = get_args(0.25);
+	const auto argv = get_argv(args);
+	freddi_model* model = freddi_create(argv.size(), argv.data(), 0);
+	BOOST_REQUIRE(model != nullptr);
+	// steps shortened to land on these moments don't count as whole time steps
+	for (const double t : {1.1, 2.3, 2.4, 5.05}) {
+		BOOST_REQUIRE_EQUAL(freddi_evolve_to(model, dayToS(t)), 1);
+		BOOST_CHECK_EQUAL(freddi_i_t(model), static_cast<size_t>(t / 0.25));
+	}
+	while (freddi_step(model) == 1) {
+	}
+	BOOST_CHECK_EQUAL(freddi_i_t(model), 80);
+	BOOST_CHECK_CLOSE_FRACTION(freddi_time(model), dayToS(20.), 1e-12);
+	freddi_destroy(model);
+}
+
+BOOST_AUTO_TEST_CASE(testRunBatch_vs_single_models) {
+	const std::vector<double> alphas = {0.1, 0.2, 0.3, 0.4, 0.5};
+	std::vector<std::vector<std::string>> args;
+	std::vector<std::vector<const char*>> argvs;
+	for (const double alpha : alphas) {
+		args.push_back(get_args(alpha));
+	}
+	// the last model fails
+	args.back().push_back("--Nx=wrong");
+	for (const auto& a : args) {
+		argvs.push_back(get_argv(a));
+	}
+	std::vector<int> argcs;
+	std::vector<const char* const*> argv_ptrs;
+	for (const auto& argv : argvs) {
+		argcs.push_back(argv.size());
+		argv_ptrs.push_back(argv.data());
+	}
+	// the last time moment is not reached
+	const std::vector<double> times = {dayToS(1.), dayToS(5.5), dayToS(19.), dayToS(25.)};
+	const std::vector<const char*> names = {"Mdot", "Mdisk"};
+
+	std::vector<double> values(alphas.size() * times.size() * names.size());
+	std::vector<int> status(alphas.size());
+	const int failed = freddi_run_batch(0, alphas.size(), argcs.data(), argv_ptrs.data(), times.size(), times.data(),
+			names.size(), names.data(), values.data(), status.data(), 3);
+	BOOST_CHECK_EQUAL(failed, 1);
+	BOOST_CHECK_EQUAL(status.back(), -1);
+
+	for (size_t i = 0; i + 1 < alphas.size(); ++i) {
+		BOOST_CHECK_EQUAL(status[i], 0);
+		freddi_model* model = freddi_create(argcs[i], argv_ptrs[i], 0);
+		BOOST_REQUIRE(model != nullptr);
+		for (size_t j = 0; j < times.size(); ++j) {
+			const double* batch_values = values.data() + (i * times.size() + j) * names.size();
+			if (freddi_evolve_to(model, times[j]) != 1) {
+				BOOST_CHECK_EQUAL(j, times.size() - 1);
+				BOOST_CHECK(std::isnan(batch_values[0]));
+				continue;
+			}
+			std::vector<double> single_values(names.size());
+			BOOST_REQUIRE_EQUAL(freddi_scalars(model, names.size(), names.data(), single_values.data()), 0);
+			for (size_t k = 0; k < names.size(); ++k) {
+				BOOST_CHECK_EQUAL(batch_values[k], single_values[k]);
+			}
+		}
+		freddi_destroy(model);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testCreate_neutron_star) {
+	auto args = get_args(0.25);
+	args[0] = "--Mx=1.4";
+	args.push_back("--Bx=1e8");
+	const auto argv = get_argv(args);
+	freddi_model* model = freddi_create(argv.size(), argv.data(), 1);
+	BOOST_REQUIRE(model != nullptr);
+	bool has_Lxns = false;
+	for (size_t i = 0; i < freddi_scalar_count(model); ++i) {
+		has_Lxns = has_Lxns || std::string(freddi_scalar_name(model, i)) == "Lxns";
+	}
+	BOOST_CHECK(has_Lxns);
+	BOOST_CHECK(freddi_scalar_name(model, freddi_scalar_count(model)) == nullptr);
+	BOOST_CHECK_EQUAL(freddi_step(model), 1);
+	freddi_destroy(model);
+}
+
+BOOST_AUTO_TEST_CASE(testStep_negative_Mdot) {
+	// the accretion rate onto this neutron star is slightly negative from the start
+	auto args = get_args(0.25);
+	args[0] = "--Mx=2.8e33";
+	args.push_back("--Bx=1e8");
+	const auto argv = get_argv(args);
+	freddi_model* model = freddi_create(argv.size(), argv.data(), 1);
+	BOOST_REQUIRE(model != nullptr);
+	const char* name = "Mdot";
+	double Mdot;
+	BOOST_REQUIRE_EQUAL(freddi_scalars(model, 1, &name, &Mdot), 0);
+	BOOST_CHECK_LT(Mdot, 0.);
+	// the quiescent time step is disabled by default, so every step is tau
+	size_t steps = 0;
+	while (freddi_step(model) == 1) {
+		++steps;
+	}
+	BOOST_CHECK_EQUAL(steps, 80);
+	freddi_destroy(model);
+}
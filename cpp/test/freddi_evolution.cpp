@@ -0,0 +1,73 @@
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <freddi_evolution.hpp>
+#include <options.hpp>
+#include <unit_transformation.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_freddi_evolution
+
+#include <boost/test/unit_test.hpp>
+
+
+FreddiOptions get_options(const std::vector<std::string>& extra_args) {
+	std::vector<std::string> args = {"--Mx=5", "--Mopt=0.5", "--period=0.2315", "--F0=2e38", "--initialcond=powerF",
+									 "--powerorder=6", "--alpha=0.25", "--distance=1", "--time=200", "--tau=0.25",
+									 "--Nx=200"};
+	args.insert(args.end(), extra_args.begin(), extra_args.end());
+	const auto desc = FreddiOptions::description();
+	po::variables_map vm;
+	po::store(po::command_line_parser(args).options(desc).run(), vm);
+	po::notify(vm);
+	return FreddiOptions(vm);
+}
+
+class StepCountingEvolution: public FreddiEvolution {
+public:
+	size_t steps = 0;
+public:
+	using FreddiEvolution::FreddiEvolution;
+	void step(const double tau) override {
+		++steps;
+		FreddiEvolution::step(tau);
+	}
+};
+
+
+BOOST_AUTO_TEST_CASE(testEvolveTo_self_similar_steps) {
+	StepCountingEvolution numerical(get_options({}));
+	StepCountingEvolution analytical(get_options({"--selfsimilartol=1e-3"}));
+	BOOST_REQUIRE(numerical.evolve_to(dayToS(100.)));
+	BOOST_REQUIRE(analytical.evolve_to(dayToS(100.)));
+	BOOST_CHECK_EQUAL(numerical.steps, 400);
+	// the self-similar decay is reached before 100 days, then every output moment costs a single step
+	BOOST_CHECK_LT(analytical.steps, numerical.steps);
+
+	for (const double t : {120., 150.5, 200.}) {
+		const size_t numerical_steps = numerical.steps;
+		const size_t analytical_steps = analytical.steps;
+		BOOST_REQUIRE(numerical.evolve_to(dayToS(t)));
+		BOOST_REQUIRE(analytical.evolve_to(dayToS(t)));
+		BOOST_CHECK_GT(numerical.steps - numerical_steps, 1);
+		BOOST_CHECK_EQUAL(analytical.steps - analytical_steps, 1);
+		BOOST_CHECK_CLOSE_FRACTION(analytical.t(), numerical.t(), 1e-12);
+		BOOST_CHECK_CLOSE_FRACTION(analytical.Mdot_in(), numerical.Mdot_in(), 1e-2);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testEvolveTo_self_similar_stop_Mdot) {
+	FreddiEvolution jumping(get_options({"--selfsimilartol=1e-3"}));
+	BOOST_REQUIRE(jumping.evolve_to(dayToS(150.1)));
+	std::ostringstream stop_Mdot;
+	stop_Mdot << std::setprecision(17) << jumping.Mdot_in();
+
+	// a stop condition keeps the time steps of the self-similar decay, so it is met at the first step after 150.1 days
+	StepCountingEvolution stopping(get_options({"--selfsimilartol=1e-3", "--stopMdot=" + stop_Mdot.str()}));
+	BOOST_CHECK(!stopping.evolve_to(dayToS(200.)));
+	BOOST_CHECK(stopping.stop_reason() != nullptr);
+	BOOST_CHECK_EQUAL(stopping.steps, 601);
+	BOOST_CHECK_CLOSE_FRACTION(stopping.t(), dayToS(150.25), 1e-12);
+}
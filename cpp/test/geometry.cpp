@@ -1,5 +1,12 @@
+#define BENCH
+
 #include <cmath>
 #include <numeric>
+#ifdef BENCH
+#include <chrono>
+#include <cstdlib>  // getenv
+#include <iostream>
+#endif
 
 #include <boost/math/special_functions/pow.hpp>
 
@@ -23,6 +30,28 @@ BOOST_AUTO_TEST_CASE(testVec3_norm) {
 	BOOST_CHECK_CLOSE(vec2.length(), std::sqrt(3.0), 1e-12);
 }
 
+BOOST_AUTO_TEST_CASE(testVec3_squaredLength) {
+	const Vec3 vec1 = {3.0, 4.0, 0.0};
+	BOOST_CHECK_EQUAL(vec1.squaredLength(), 25.0);
+
+	const UnitVec3 uvec1(vec1);
+	BOOST_CHECK_EQUAL(uvec1.squaredLength(), 1.0);
+	BOOST_CHECK_CLOSE(static_cast<const Vec3&>(uvec1).squaredLength(), 1.0, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(testVec3_length_after_arithmetic) {
+	const Vec3 vec1 = {3.0, 4.0, 0.0};
+	const Vec3 vec2 = {0.0, 0.0, 12.0};
+	BOOST_CHECK_CLOSE((vec1 * 2.0).length(), 10.0, 1e-12);
+	BOOST_CHECK_CLOSE((vec1 / 5.0).length(), 1.0, 1e-12);
+	BOOST_CHECK_CLOSE((vec1 + vec2).length(), 13.0, 1e-12);
+	BOOST_CHECK_CLOSE((vec1 - vec2).length(), 13.0, 1e-12);
+
+	Vec3 vec3 = vec1;
+	vec3 *= -3.0;
+	BOOST_CHECK_CLOSE(vec3.length(), 15.0, 1e-12);
+}
+
 BOOST_AUTO_TEST_CASE(testVec3_dotProduct) {
 	const Vec3 vec1 = {1.0, 0.0, 0.0};
 	const Vec3 vec2 = {0.0, 1.0, 0.0};
@@ -70,6 +99,13 @@ BOOST_AUTO_TEST_CASE(testUnitVec3_length) {
 	BOOST_CHECK_CLOSE(uvec1.dotProduct(uvec1), 1.0, 1e-12);
 }
 
+BOOST_AUTO_TEST_CASE(testUnitVec3_known_length) {
+	const Vec3 vec1 = {-1.0, 2.0, -3.0};
+	const UnitVec3 uvec1(vec1);
+	const UnitVec3 uvec2(vec1, vec1.length());
+	BOOST_CHECK_EQUAL(uvec1, uvec2);
+}
+
 BOOST_AUTO_TEST_CASE(testUnitVec3_direction) {
 	const Vec3 vec1 = {-1.0, 2.0, -3.0};
 	const UnitVec3 uvec1(vec1);
@@ -265,3 +301,55 @@ BOOST_AUTO_TEST_CASE(testUnitSphere_projected_area) {
 		}
 	}
 }
+
+#ifdef BENCH
+// Benchmarks are skipped unless FREDDI_BENCH is set
+const bool bench_enabled = std::getenv("FREDDI_BENCH") != nullptr;
+const std::chrono::milliseconds bench_duration(1000);
+
+BOOST_AUTO_TEST_CASE(benchVec3_arithmetic) {
+	if (!bench_enabled) {
+		return;
+	}
+	const auto start = std::chrono::high_resolution_clock::now();
+	size_t count = 0;
+	const size_t n = 1000;
+	const Vec3 shift(0.0, 1.0, 0.0);
+	Vec3 sum(0.0, 0.0, 0.0);
+
+	for (; std::chrono::high_resolution_clock::now() - start < bench_duration; ++count) {
+		Vec3 vec(1.0, 2.0, 3.0);
+		for (size_t i = 0; i < n; ++i) {
+			vec = 0.5 * (vec + shift) - shift * 0.25;
+			sum = sum + vec * 1e-3;
+		}
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	std::cout
+		<< "BENCH. Vec3 arithmetic time (" << n << " iterations of +, - and *): "
+		<< std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / (1000.0 * count) << " us"
+		<< " (checksum " << sum.x() << ")"
+		<< std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(benchUnitSphere_5) {
+	if (!bench_enabled) {
+		return;
+	}
+	const auto start = std::chrono::high_resolution_clock::now();
+	size_t count = 0;
+
+	for (; std::chrono::high_resolution_clock::now() - start < bench_duration; ++count) {
+		const auto triangles = unit_sphere_triangles(5);
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	std::cout
+		<< "BENCH. Unit sphere triangulation time (lod=5): "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / (1000.0 * count) << " ms"
+		<< std::endl;
+}
+#endif
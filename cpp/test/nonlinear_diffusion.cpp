@@ -0,0 +1,197 @@
+#define BENCH
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+#ifdef BENCH
+#include <chrono>
+#include <cstdlib>  // getenv
+#include <iostream>
+#endif
+
+#include <nonlinear_diffusion.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_nonlinear_diffusion
+
+#include <boost/test/unit_test.hpp>
+
+
+class PowerLawW {
+private:
+	const vecd& x_;
+public:
+	explicit PowerLawW(const vecd& x): x_(x) {}
+	double w(size_t i, double y) const { return std::pow(std::abs(y), 0.7) * std::pow(x_[i], 0.8); }
+};
+
+vecd power_law_wunc(const vecd& x, const vecd& y, size_t first, size_t last) {
+	vecd W(last + 1, 0.);
+	for (size_t i = first; i <= last; ++i) {
+		W[i] = std::pow(std::abs(y[i]), 0.7) * std::pow(x[i], 0.8);
+	}
+	return W;
+}
+
+vecd get_x(size_t N) {
+	vecd x(N);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = 1. + i / (N - 1.);
+	}
+	return x;
+}
+
+vecd get_y(const vecd& x) {
+	vecd y(x.size());
+	for (size_t i = 0; i < x.size(); ++i) {
+		y[i] = (x[i] - x[0]) * std::exp(-x[i]);
+	}
+	return y;
+}
+
+
+BOOST_AUTO_TEST_CASE(test_w_provider_vs_wunc) {
+	const size_t N = 100;
+	const auto x = get_x(N);
+	const vecd A(N, 0.), B(N, 0.), C(N, 0.);
+	auto y_template = get_y(x);
+	auto y_function = y_template;
+	const std::function<vecd (const vecd&, const vecd&, size_t, size_t)> wunc = power_law_wunc;
+
+	for (size_t i_t = 0; i_t < 10; ++i_t) {
+		nonlinear_diffusion_nonuniform_wind_1_2(1e-3, 1e-6, 0., 0., A, B, C, PowerLawW(x), x, y_template, 0, N - 1);
+		nonlinear_diffusion_nonuniform_wind_1_2(1e-3, 1e-6, 0., 0., A, B, C, wunc, x, y_function, 0, N - 1);
+	}
+	for (size_t i = 0; i < N; ++i) {
+		BOOST_CHECK_EQUAL(y_template[i], y_function[i]);
+	}
+}
+
+class LinearW {
+public:
+	double w(size_t, double y) const { return y; }
+};
+
+// Error of the linear diffusion solution y = exp(-k^2 t) sin(k x), y(0) = 0, y'(1) = 0, at t = 0.5
+template <typename Solver>
+double linear_diffusion_error(const Solver& solver, const double tau) {
+	const size_t N = 401;
+	const double k = 0.5 * M_PI;
+	const double time = 0.5;
+	vecd x(N), y(N);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = i / (N - 1.);
+		y[i] = std::sin(k * x[i]);
+	}
+	const vecd A(N, 0.), B(N, 0.), C(N, 0.);
+	const auto n_t = static_cast<size_t>(std::round(time / tau));
+	for (size_t i_t = 0; i_t < n_t; ++i_t) {
+		solver(tau, 1e-12, 0., 0., A, B, C, LinearW(), x, y, 0, N - 1);
+	}
+	double error = 0.;
+	for (size_t i = 0; i < N; ++i) {
+		error = std::max(error, std::abs(y[i] - std::exp(-k * k * time) * std::sin(k * x[i])));
+	}
+	return error;
+}
+
+BOOST_AUTO_TEST_CASE(test_time_order) {
+	const auto euler = [](auto&&... args) { nonlinear_diffusion_nonuniform_wind_1_2(args...); };
+	const auto trbdf2 = [](auto&&... args) { nonlinear_diffusion_nonuniform_wind_2_2(args...); };
+	const double euler_ratio = linear_diffusion_error(euler, 0.05) / linear_diffusion_error(euler, 0.025);
+	const double trbdf2_ratio = linear_diffusion_error(trbdf2, 0.05) / linear_diffusion_error(trbdf2, 0.025);
+	BOOST_CHECK_CLOSE(euler_ratio, 2., 10.);
+	BOOST_CHECK_CLOSE(trbdf2_ratio, 4., 10.);
+	BOOST_CHECK_LT(linear_diffusion_error(trbdf2, 0.1), linear_diffusion_error(euler, 0.01));
+}
+
+BOOST_AUTO_TEST_CASE(test_time_order_nonlinear) {
+	const size_t N = 201;
+	const auto x = get_x(N);
+	const vecd A(N, 0.), B(N, 0.), C(N, 0.);
+	const auto solve = [&](const double tau) {
+		auto y = get_y(x);
+		const auto n_t = static_cast<size_t>(std::round(0.2 / tau));
+		for (size_t i_t = 0; i_t < n_t; ++i_t) {
+			nonlinear_diffusion_nonuniform_wind_2_2(tau, 1e-12, 0., 0., A, B, C, PowerLawW(x), x, y, 0, N - 1);
+		}
+		return y;
+	};
+	const auto y_ref = solve(1e-4);
+	const auto error = [&](const double tau) {
+		const auto y = solve(tau);
+		return max_dif_rel(y_ref, y, 1, N - 1);
+	};
+	BOOST_CHECK_CLOSE(error(0.02) / error(0.01), 4., 10.);
+}
+
+// Error of the linear diffusion solution on the stretched grid, see linear_diffusion_error
+template <typename Solver>
+double linear_diffusion_space_error(const Solver& solver, const size_t N) {
+	const double k = 0.5 * M_PI;
+	const double time = 0.1;
+	const double tau = 2.5e-4;
+	vecd x(N), y(N);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = std::expm1(2. * i / (N - 1.)) / std::expm1(2.);
+		y[i] = std::sin(k * x[i]);
+	}
+	const vecd A(N, 0.), B(N, 0.), C(N, 0.);
+	const auto n_t = static_cast<size_t>(std::round(time / tau));
+	for (size_t i_t = 0; i_t < n_t; ++i_t) {
+		solver(tau, 1e-12, 0., 0., A, B, C, LinearW(), x, y, 0, N - 1);
+	}
+	double error = 0.;
+	for (size_t i = 0; i < N; ++i) {
+		error = std::max(error, std::abs(y[i] - std::exp(-k * k * time) * std::sin(k * x[i])));
+	}
+	return error;
+}
+
+BOOST_AUTO_TEST_CASE(test_space_order) {
+	const auto second = [](auto&&... args) { nonlinear_diffusion_nonuniform_wind_2_2(args...); };
+	const auto fourth = [](auto&&... args) { nonlinear_diffusion_nonuniform_wind_2_4(args...); };
+	BOOST_CHECK_CLOSE(linear_diffusion_space_error(second, 21) / linear_diffusion_space_error(second, 41), 4., 10.);
+	BOOST_CHECK_GT(linear_diffusion_space_error(fourth, 21) / linear_diffusion_space_error(fourth, 41), 16.);
+	BOOST_CHECK_LT(linear_diffusion_space_error(fourth, 21), linear_diffusion_space_error(second, 81));
+}
+
+
+#ifdef BENCH
+// Set FREDDI_BENCH to run the benchmarks, they take a second per loop
+const bool bench_enabled = std::getenv("FREDDI_BENCH") != nullptr;
+const std::chrono::milliseconds bench_duration(1000);
+
+BOOST_AUTO_TEST_CASE(bench_w_provider_vs_wunc) {
+	if (!bench_enabled) {
+		return;
+	}
+	const size_t N = 1000;
+	const auto x = get_x(N);
+	const vecd A(N, 0.), B(N, 0.), C(N, 0.);
+	const std::function<vecd (const vecd&, const vecd&, size_t, size_t)> wunc = power_law_wunc;
+
+	auto y = get_y(x);
+	auto start = std::chrono::high_resolution_clock::now();
+	size_t count = 0;
+	for (; std::chrono::high_resolution_clock::now() - start < bench_duration; ++count) {
+		nonlinear_diffusion_nonuniform_wind_1_2(1e-5, 1e-6, 0., 0., A, B, C, wunc, x, y, 0, N - 1);
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "BENCH. Diffusion step, std::function wunc, Nx = " << N << ": "
+			  << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / static_cast<double>(count) << " us "
+			  << "(" << y[N / 2] << ")" << std::endl;
+
+	y = get_y(x);
+	start = std::chrono::high_resolution_clock::now();
+	count = 0;
+	for (; std::chrono::high_resolution_clock::now() - start < bench_duration; ++count) {
+		nonlinear_diffusion_nonuniform_wind_1_2(1e-5, 1e-6, 0., 0., A, B, C, PowerLawW(x), x, y, 0, N - 1);
+	}
+	end = std::chrono::high_resolution_clock::now();
+	std::cout << "BENCH. Diffusion step, W-provider, Nx = " << N << ": "
+			  << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / static_cast<double>(count) << " us "
+			  << "(" << y[N / 2] << ")" << std::endl;
+}
+#endif // BENCH
@@ -0,0 +1,180 @@
+#include <cstdio>  // remove
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <freddi_evolution.hpp>
+#include <options.hpp>
+#include <output.hpp>
+#include <passband.hpp>
+#include <server.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_server
+
+#include <boost/test/unit_test.hpp>
+
+namespace pt = boost::property_tree;
+
+
+const std::string options_json = "{\"Mx\": 5, \"Mopt\": 0.5, \"period\": 0.2315, \"F0\": 2e38, \"initialcond\": \"powerF\", "
+								 "\"powerorder\": 6, \"alpha\": 0.25, \"distance\": 1, \"time\": 20, \"tau\": 0.25, \"Nx\": 100}";
+
+pt::ptree parse_json(const std::string& line) {
+	pt::ptree tree;
+	std::istringstream stream(line);
+	pt::read_json(stream, tree);
+	return tree;
+}
+
+
+BOOST_AUTO_TEST_CASE(testServerRequest_fromJson) {
+	const auto request = ServerRequest::fromJson(
+			"{\"id\": \"a\", \"options\": {\"alpha\": 0.3, \"passband\": [\"B.dat\", \"V.dat\"], \"fulldata\": true, \"stdout\": false}, "
+			"\"times\": [2, 1.5], \"columns\": [\"t\", \"Mdot\"]}", "1");
+	BOOST_CHECK_EQUAL(request.id, "a");
+	const std::vector<std::string> args = {"--alpha=0.3", "--passband=B.dat", "--passband=V.dat", "--fulldata"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(request.args.begin(), request.args.end(), args.begin(), args.end());
+	const vecd times = {2., 1.5};
+	BOOST_CHECK_EQUAL_COLLECTIONS(request.times.begin(), request.times.end(), times.begin(), times.end());
+	const std::vector<std::string> columns = {"t", "Mdot"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(request.columns.begin(), request.columns.end(), columns.begin(), columns.end());
+
+	const auto empty = ServerRequest::fromJson("{}", "7");
+	BOOST_CHECK_EQUAL(empty.id, "7");
+	BOOST_CHECK(empty.args.empty() && empty.times.empty() && empty.columns.empty());
+
+	BOOST_CHECK_THROW(ServerRequest::fromJson("{\"options\": {\"alpha\": [{\"a\": 1}]}}", "1"), std::invalid_argument);
+	BOOST_CHECK_THROW(ServerRequest::fromJson("{\"options\": ", "1"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(testPassbandCache) {
+	const std::string filepath = "test_server_passband.dat";
+	const auto write_passband = [&filepath](const double lambda_max) {
+		std::ofstream file(filepath);
+		file << "4000 0\n5000 1\n" << lambda_max << " 0\n";
+	};
+	const std::vector<std::string> args = {"--Mx=5", "--Mopt=0.5", "--period=0.2315", "--F0=2e38", "--powerorder=6",
+										   "--alpha=0.25", "--distance=1", "--time=20", "--passband=" + filepath};
+	const auto desc = FreddiOptions::description();
+	po::variables_map vm;
+	po::store(po::command_line_parser(args).options(desc).run(), vm);
+	po::notify(vm);
+
+	PassbandCache cache;
+	write_passband(6000.);
+	const double t_dl = FreddiOptions(vm, &cache).flux->passbands.at(0).t_dl;
+	write_passband(7000.);
+	// the cache of the server keeps the file read first, options without a cache read it again
+	BOOST_CHECK_EQUAL(FreddiOptions(vm, &cache).flux->passbands.at(0).t_dl, t_dl);
+	BOOST_CHECK_GT(FreddiOptions(vm).flux->passbands.at(0).t_dl, t_dl);
+	std::remove(filepath.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(testServeRequest_vs_evolution) {
+	const auto desc = FreddiOptions::description();
+	// the server command line gives defaults, the request overrides them
+	const std::vector<po::parsed_options> sources = {
+			po::command_line_parser(std::vector<std::string>{"--alpha=0.5", "--Nx=150", "--kerr=0.5"}).options(desc).run()};
+	const auto request = ServerRequest::fromJson(
+			"{\"id\": \"a\", \"options\": " + options_json + ", \"times\": [5.5, 1], \"columns\": [\"t\", \"Mdot\", \"Lx\"]}", "1");
+	const auto result = parse_json(serve_request<FreddiFileOutput, FreddiOptions, FreddiEvolution>(request, desc, sources, 17));
+	BOOST_CHECK_EQUAL(result.get<std::string>("id"), "a");
+	BOOST_CHECK(!result.get_child_optional("stop"));
+
+	po::variables_map vm;
+	std::vector<std::string> args(request.args);
+	args.push_back("--kerr=0.5");
+	po::store(po::command_line_parser(args).options(desc).run(), vm);
+	po::notify(vm);
+	FreddiOptions opts(vm);
+	BOOST_CHECK_EQUAL(opts.basic->alpha, 0.25);
+	BOOST_CHECK_EQUAL(opts.calc->Nx, 100);
+	BOOST_CHECK_EQUAL(opts.basic->kerr, 0.5);
+	std::shared_ptr<FreddiEvolution> freddi{new FreddiEvolution(opts)};
+	const auto fields = FreddiFileOutput::initializeShortFields(freddi);
+
+	const auto& data = result.get_child("data");
+	BOOST_REQUIRE_EQUAL(data.size(), 2);
+	auto row = data.begin();
+	for (const double t : {1., 5.5}) {
+		BOOST_REQUIRE(freddi->evolve_to(dayToS(t)));
+		vecd values;
+		for (const auto& item : row->second) {
+			values.push_back(item.second.get_value<double>());
+		}
+		BOOST_REQUIRE_EQUAL(values.size(), 3);
+		BOOST_CHECK_CLOSE_FRACTION(values[0], t, 1e-12);
+		for (const auto& field : fields) {
+			if (field.name == "Mdot") {
+				BOOST_CHECK_CLOSE_FRACTION(values[1], field.func(), 1e-12);
+			}
+			if (field.name == "Lx") {
+				BOOST_CHECK_CLOSE_FRACTION(values[2], field.func(), 1e-12);
+			}
+		}
+		++row;
+	}
+
+	const auto wrong_column = ServerRequest::fromJson("{\"options\": " + options_json + ", \"columns\": [\"unknown\"]}", "1");
+	BOOST_CHECK_THROW((serve_request<FreddiFileOutput, FreddiOptions, FreddiEvolution>(wrong_column, desc, sources, 12)), std::invalid_argument);
+}
+
+// The test plays the client of the server connection
+BOOST_AUTO_TEST_CASE(testServeConnection) {
+	const auto desc = FreddiOptions::description();
+	const std::vector<po::parsed_options> sources;
+	int fds[2];
+	BOOST_REQUIRE_EQUAL(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+	std::thread server([&]() {
+		WorkerPool pool(2);
+		serve_connection<FreddiFileOutput, FreddiOptions, FreddiEvolution>(
+				std::make_shared<ServerConnection>(fds[0], fds[0], true), pool, desc, sources, 12);
+	});
+
+	const std::string requests =
+			"{\"id\": \"a\", \"options\": " + options_json + ", \"columns\": [\"t\"]}\n"
+			"\n"
+			"{\"options\": \n"
+			"{\"id\": \"c\", \"options\": {\"unknownoption\": 1}}\n"
+			"{\"options\": " + options_json + ", \"times\": [30], \"columns\": [\"Mdot\"]}";
+	BOOST_REQUIRE_EQUAL(write(fds[1], requests.data(), requests.size()), static_cast<ssize_t>(requests.size()));
+	shutdown(fds[1], SHUT_WR);
+
+	// the server closes the connection when all the results are written
+	std::string output;
+	char buffer[4096];
+	for (ssize_t n; (n = read(fds[1], buffer, sizeof(buffer))) > 0; ) {
+		output.append(buffer, n);
+	}
+	server.join();
+	close(fds[1]);
+
+	std::istringstream lines(output);
+	std::set<std::string> ids;
+	for (std::string line; std::getline(lines, line); ) {
+		const auto result = parse_json(line);
+		const auto id = result.get<std::string>("id");
+		ids.insert(id);
+		if (id == "a") {
+			// every time step of 20 days with tau = 0.25 day
+			BOOST_CHECK_EQUAL(result.get_child("data").size(), 81);
+		} else if (id == "5") {
+			// the only time moment is later than the end of the calculation
+			BOOST_CHECK_EQUAL(result.get_child("data").size(), 0);
+		} else {
+			BOOST_CHECK(result.get_child_optional("error"));
+		}
+	}
+	BOOST_CHECK(ids == (std::set<std::string>{"a", "3", "c", "5"}));
+}
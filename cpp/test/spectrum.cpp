@@ -0,0 +1,162 @@
+#define BENCH
+
+#include <cmath>
+#include <vector>
+#ifdef BENCH
+#include <chrono>
+#include <cstdlib>  // getenv
+#include <iostream>
+#endif
+
+#include <spectrum.hpp>
+#include <util.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_spectrum
+
+#include <boost/test/unit_test.hpp>
+
+
+vecd get_log_grid(const double x_min, const double x_max, const size_t N) {
+	vecd x(N);
+	for (size_t i = 0; i < N; i++) {
+		x[i] = x_min * std::pow(x_max / x_min, i / (N - 1.));
+	}
+	return x;
+}
+
+vecd get_T(const vecd& r) {
+	vecd T(r.size());
+	for (size_t i = 0; i < r.size(); i++) {
+		T[i] = 1e7 * std::pow(r[i] / r[0], -0.75);
+	}
+	return T;
+}
+
+
+BOOST_AUTO_TEST_CASE(testDiskRadialPlanckLambda_vs_single_lambda) {
+	const auto r = get_log_grid(1e7, 1e11, 1000);
+	auto T = get_T(r);
+	T[10] = 0.;  // zero temperature is allowed
+	const auto lambdas = get_log_grid(1e-8, 1e-3, 50);
+	const size_t first = 5;
+	const size_t last = r.size() - 3;
+
+	vecd I;
+	Spectrum::disk_radial_Planck_lambda(r, T, first, last, lambdas, I);
+	BOOST_CHECK_EQUAL(I.size(), lambdas.size());
+	for (size_t j = 0; j < lambdas.size(); ++j) {
+		const double lambda = lambdas[j];
+		const double expected = disk_radial_trapz(r, [&T, lambda](const size_t i) { return Spectrum::Planck_lambda(T[i], lambda); }, first, last);
+		BOOST_CHECK_CLOSE_FRACTION(I[j], expected, 1e-12);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testDiskRadialPlanckLambda_empty_region) {
+	const auto r = get_log_grid(1e7, 1e11, 10);
+	const auto T = get_T(r);
+	const vecd lambdas = {1e-5, 1e-4};
+
+	vecd I = {1.0};
+	Spectrum::disk_radial_Planck_lambda(r, T, 9, 9, lambdas, I);
+	BOOST_CHECK_EQUAL(I.size(), lambdas.size());
+	BOOST_CHECK_EQUAL(I[0], 0.);
+	BOOST_CHECK_EQUAL(I[1], 0.);
+}
+
+BOOST_AUTO_TEST_CASE(testFrequencyBands_vs_single_band) {
+	// overlapping, adjacent and separate bands
+	const vecd nu1 = {1e17, 5e17, 1e17, 3e18, 2e17};
+	const vecd nu2 = {5e17, 2e18, 2e18, 5e18, 4e17};
+	const Spectrum::FrequencyBands bands(nu1, nu2);
+	BOOST_CHECK_EQUAL(bands.size(), nu1.size());
+	for (const double T : {0., 1e6, 1e7, 3e7}) {
+		for (const double nu_divider : {1., 1.3}) {
+			vecd integrals;
+			bands.Planck_nu1_nu2(T, integrals, 1e-8, nu_divider);
+			BOOST_CHECK_EQUAL(integrals.size(), nu1.size());
+			for (size_t j = 0; j < nu1.size(); ++j) {
+				const double expected = Spectrum::Planck_nu1_nu2(T, nu1[j] / nu_divider, nu2[j] / nu_divider, 1e-8);
+				BOOST_CHECK_CLOSE_FRACTION(integrals[j], expected, 1e-6);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testDiskRadialPlanckNu1Nu2_vs_single_band) {
+	const auto r = get_log_grid(1e7, 1e11, 200);
+	const auto T = get_T(r);
+	const vecd nu1 = {1e17, 5e17};
+	const vecd nu2 = {5e17, 3e18};
+	const Spectrum::FrequencyBands bands(nu1, nu2);
+	const size_t first = 3;
+	const size_t last = r.size() - 5;
+
+	vecd I;
+	Spectrum::disk_radial_Planck_nu1_nu2(r, T, first, last, bands, I, 1e-6);
+	BOOST_CHECK_EQUAL(I.size(), nu1.size());
+	for (size_t j = 0; j < nu1.size(); ++j) {
+		const double expected = disk_radial_trapz(r, [&T, &nu1, &nu2, j](const size_t i) { return Spectrum::Planck_nu1_nu2(T[i], nu1[j], nu2[j], 1e-6); }, first, last);
+		BOOST_CHECK_CLOSE_FRACTION(I[j], expected, 1e-10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testQvisGROverMdot_vs_T_GR) {
+	const double Mx = 2e34;
+	const double Mdot = 1e18;
+	const double r_g = GSL_CONST_CGSM_GRAVITATIONAL_CONSTANT * Mx / (GSL_CONST_CGSM_SPEED_OF_LIGHT * GSL_CONST_CGSM_SPEED_OF_LIGHT);
+	for (const double kerr : {0.0, 0.5, 0.9}) {
+		// inside ISCO
+		BOOST_CHECK_EQUAL(Spectrum::Qvis_GR_over_Mdot(r_g, kerr, Mx), 0.);
+		for (const double r : get_log_grid(10. * r_g, 1e5 * r_g, 20)) {
+			const double T = Spectrum::T_GR(r, kerr, Mx, Mdot);
+			BOOST_CHECK_CLOSE_FRACTION(Mdot * Spectrum::Qvis_GR_over_Mdot(r, kerr, Mx), GSL_CONST_CGSM_STEFAN_BOLTZMANN_CONSTANT * T * T * T * T, 1e-12);
+		}
+	}
+}
+
+
+#ifdef BENCH
+// The benchmark runs only if FREDDI_BENCH is set
+const bool bench_enabled = std::getenv("FREDDI_BENCH") != nullptr;
+const std::chrono::milliseconds bench_duration(1000);
+
+BOOST_AUTO_TEST_CASE(benchDiskRadialPlanckLambda) {
+	if (!bench_enabled) {
+		return;
+	}
+
+	const auto r = get_log_grid(1e7, 1e11, 1000);
+	const auto T = get_T(r);
+	const auto lambdas = get_log_grid(1e-6, 1e-3, 100);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	size_t count = 0;
+	double sum = 0.;
+	for (; std::chrono::high_resolution_clock::now() - start < bench_duration; ++count) {
+		sum = 0.;
+		for (const double lambda : lambdas) {
+			sum += disk_radial_trapz(r, [&T, lambda](const size_t i) { return Spectrum::Planck_lambda(T[i], lambda); }, 0, r.size() - 1);
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "BENCH. Disk spectrum, wavelength by wavelength, " << lambdas.size() << " wavelengths: "
+			  << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / (1000.0 * count) << " ms "
+			  << "(" << sum << ")" << std::endl;
+
+	start = std::chrono::high_resolution_clock::now();
+	count = 0;
+	vecd I;
+	for (; std::chrono::high_resolution_clock::now() - start < bench_duration; ++count) {
+		Spectrum::disk_radial_Planck_lambda(r, T, 0, r.size() - 1, lambdas, I);
+		sum = 0.;
+		for (const double x : I) {
+			sum += x;
+		}
+	}
+	end = std::chrono::high_resolution_clock::now();
+	std::cout << "BENCH. Disk spectrum, single pass, " << lambdas.size() << " wavelengths: "
+			  << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / (1000.0 * count) << " ms "
+			  << "(" << sum << ")" << std::endl;
+}
+#endif // BENCH
@@ -65,6 +65,32 @@ BOOST_AUTO_TEST_CASE(testStar_luminosity_passband) {
 }
 
 
+BOOST_AUTO_TEST_CASE(testIrrStar_luminosities_vs_luminosity) {
+	const double temp = 5000;
+	const double radius = 5e10;
+	const double semiaxis = 1e12;
+
+	IrradiatedStar::sources_t sources;
+	sources.push_back(std::make_unique<PointAccretorSource>(Vec3(-semiaxis, 0.0, 0.0), 1e36, 0.0, 0.0));
+	IrradiatedStar star(std::move(sources), temp, radius, 3);
+
+	const std::vector<UnitVec3> directions = {{0.7, 0.0}, {0.7, M_PI}, {0.7, 1.3}};
+	const vecd lambdas = {angstromToCm(3000), angstromToCm(5510), angstromToCm(9000)};
+	const double lambda_V = angstromToCm(5510);
+	const std::vector<Passband> passbands = {{"V", {{lambda_V, 1.0}, {lambda_V * 1.01, 0.5}, {lambda_V * 1.02, 1.0}}}};
+
+	const auto lum = star.luminosities(directions, lambdas, passbands);
+	BOOST_CHECK_EQUAL(lum.size(), directions.size());
+	for (size_t i_dir = 0; i_dir < directions.size(); ++i_dir) {
+		BOOST_CHECK_EQUAL(lum[i_dir].size(), lambdas.size() + passbands.size());
+		for (size_t i_lambda = 0; i_lambda < lambdas.size(); ++i_lambda) {
+			BOOST_CHECK_CLOSE_FRACTION(lum[i_dir][i_lambda], star.luminosity(directions[i_dir], lambdas[i_lambda]), 1e-12);
+		}
+		BOOST_CHECK_CLOSE_FRACTION(lum[i_dir][lambdas.size()], star.luminosity(directions[i_dir], passbands[0]), 1e-12);
+	}
+}
+
+
 BOOST_AUTO_TEST_CASE(testStar_Roche_vs_spherical_small_roche_fill) {
 	const double temp = 5772;
 	const double solar_lum =
@@ -331,4 +357,44 @@ BOOST_AUTO_TEST_CASE(benchRoche_star5) {
 		<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / (1000.0 * count) << " ms"
 		<< std::endl;
 }
+
+BOOST_AUTO_TEST_CASE(benchStar_luminosities) {
+	const double temp = 5000;
+	const RocheLobe roche_lobe(1e12, 0.1, 0.8);
+	IrradiatedStar::sources_t sources;
+	sources.push_back(std::make_unique<PointAccretorSource>(Vec3(-1e12, 0.0, 0.0), 1e37, 0.0, 0.0));
+	IrradiatedStar star(std::move(sources), temp, roche_lobe, 3);
+
+	const std::vector<UnitVec3> directions = {{0.7, 1.0}, {0.7, 0.0}, {0.7, M_PI}};
+	vecd lambdas;
+	for (size_t i = 0; i < 8; ++i) {
+		lambdas.push_back(angstromToCm(3000.0 + 1000.0 * static_cast<double>(i)));
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+	size_t count = 0;
+	for (; std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() < bench_duration_ms; ++count) {
+		for (const auto& direction : directions) {
+			for (const double lambda : lambdas) {
+				star.luminosity(direction, lambda);
+			}
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	std::cout
+		<< "BENCH. Star luminosities, band by band, 8 bands x 3 directions (lod=3): "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / static_cast<double>(count) << " us"
+		<< std::endl;
+
+	start = std::chrono::high_resolution_clock::now();
+	count = 0;
+	for (; std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() < bench_duration_ms; ++count) {
+		star.luminosities(directions, lambdas, {});
+	}
+	end = std::chrono::high_resolution_clock::now();
+	std::cout
+		<< "BENCH. Star luminosities, single pass, 8 bands x 3 directions (lod=3): "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / static_cast<double>(count) << " us"
+		<< std::endl;
+}
 #endif
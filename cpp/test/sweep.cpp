@@ -0,0 +1,116 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <freddi_evolution.hpp>
+#include <options.hpp>
+#include <output.hpp>
+#include <sweep.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_sweep
+
+#include <boost/test/unit_test.hpp>
+
+
+po::options_description get_desc() {
+	auto desc = FreddiOptions::description();
+	desc.add(SweepOptions::description());
+	return desc;
+}
+
+po::variables_map get_vm(const po::options_description& desc, const std::vector<std::string>& args) {
+	po::variables_map vm;
+	po::store(po::command_line_parser(args).options(desc).run(), vm);
+	return vm;
+}
+
+std::vector<std::string> read_lines(const std::string& path) {
+	std::ifstream file(path);
+	std::vector<std::string> lines;
+	for (std::string line; std::getline(file, line); ) {
+		if (line[0] != '#') {
+			lines.push_back(line);
+		}
+	}
+	return lines;
+}
+
+
+BOOST_AUTO_TEST_CASE(testSweepOptions_grid) {
+	const auto desc = get_desc();
+	const SweepOptions sweep(get_vm(desc, {"--grid", "alpha=0.1,0.2", "--grid", "Mx=5:15:3", "--grid", "F0=1e37:1e39:3:log", "--columns=t,Mdot"}));
+	BOOST_REQUIRE_EQUAL(sweep.grid.size(), 3);
+	BOOST_CHECK_EQUAL(sweep.grid[0].first, "alpha");
+	const std::vector<std::string> alpha = {"0.1", "0.2"};
+	const std::vector<std::string> Mx = {"5", "10", "15"};
+	const std::vector<std::string> F0 = {"1e+37", "1e+38", "1e+39"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(sweep.grid[0].second.begin(), sweep.grid[0].second.end(), alpha.begin(), alpha.end());
+	BOOST_CHECK_EQUAL_COLLECTIONS(sweep.grid[1].second.begin(), sweep.grid[1].second.end(), Mx.begin(), Mx.end());
+	BOOST_CHECK_EQUAL_COLLECTIONS(sweep.grid[2].second.begin(), sweep.grid[2].second.end(), F0.begin(), F0.end());
+	BOOST_CHECK_EQUAL(sweep.columns.size(), 2);
+
+	for (const std::string wrong : {"alpha", "alpha=", "alpha=0.1,,0.2", "Mx=5:15", "Mx=5:15:0", "F0=0:1e39:3:log", "Mx=5:15:3:lin"}) {
+		BOOST_CHECK_THROW(SweepOptions(get_vm(desc, {"--grid", wrong})), po::error);
+	}
+	BOOST_CHECK_THROW(SweepOptions(get_vm(desc, {})), po::error);
+	BOOST_CHECK_THROW(SweepOptions(get_vm(desc, {"--grid", "alpha=0.1", "--list=list.txt"})), po::error);
+}
+
+BOOST_AUTO_TEST_CASE(testSweepParameterSets_grid_order) {
+	const SweepOptions sweep(get_vm(get_desc(), {"--grid", "alpha=0.1,0.2", "--grid", "Mx=5,10,15"}));
+	SweepParameterSets sets(sweep);
+	std::string line;
+	std::vector<std::string> ids;
+	while (sets.next(line)) {
+		const auto request = ServerRequest::fromJson(line, "");
+		ids.push_back(request.id);
+		BOOST_CHECK_EQUAL(request.args.size(), 2);
+	}
+	const std::vector<std::string> expected = {"alpha=0.1 Mx=5", "alpha=0.1 Mx=10", "alpha=0.1 Mx=15",
+											   "alpha=0.2 Mx=5", "alpha=0.2 Mx=10", "alpha=0.2 Mx=15"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expected.begin(), expected.end());
+	BOOST_CHECK(!sets.next(line));
+}
+
+BOOST_AUTO_TEST_CASE(testSweepStore) {
+	const auto desc = get_desc();
+	const std::vector<po::parsed_options> sources = {po::command_line_parser(std::vector<std::string>{
+			"--Mx=5", "--Mopt=0.5", "--period=0.2315", "--F0=2e38", "--initialcond=powerF", "--powerorder=6",
+			"--alpha=0.25", "--distance=1", "--time=2", "--tau=0.25", "--Nx=100"}).options(desc).run()};
+	const SweepOptions sweep(get_vm(desc, {"--grid", "alpha=0.1", "--columns=t,Mdot", "--prefix=test_sweep"}));
+
+	const std::vector<std::string> results = {
+			sweep_result<FreddiFileOutput, FreddiOptions, FreddiEvolution>(1, "{\"id\": \"a\", \"times\": [1, 2]}", sweep, desc, sources),
+			sweep_result<FreddiFileOutput, FreddiOptions, FreddiEvolution>(2, "{\"options\": {\"Nx\": \"x\"}}", sweep, desc, sources),
+			sweep_result<FreddiFileOutput, FreddiOptions, FreddiEvolution>(3, "{\"columns\": [\"t\"]}", sweep, desc, sources),
+			sweep_result<FreddiFileOutput, FreddiOptions, FreddiEvolution>(4, "{\"options\": {\"alpha\": 0.5, \"time\": 0.5}}", sweep, desc, sources),
+	};
+	BOOST_CHECK_EQUAL(results[1], "2\t2\terror\tthe argument ('x') for option '--Nx' is invalid\n");
+	{
+		SweepStore store(sweep);
+		for (const auto& result : results) {
+			store.write(result);
+		}
+		BOOST_CHECK_EQUAL(store.failed(), 2);
+	}
+
+	const auto rows = read_lines("./test_sweep.dat");
+	BOOST_REQUIRE_EQUAL(rows.size(), 5);
+	BOOST_CHECK_EQUAL(rows[0].substr(0, 4), "1\t1\t");
+	BOOST_CHECK_EQUAL(rows[1].substr(0, 4), "1\t2\t");
+	BOOST_CHECK_EQUAL(rows[2].substr(0, 4), "4\t0\t");
+	BOOST_CHECK_EQUAL(rows[4].substr(0, 6), "4\t0.5\t");
+	const auto status = read_lines("./test_sweep_status.dat");
+	const std::vector<std::string> expected_status = {
+			"1\ta\tok\t",
+			"2\t2\terror\tthe argument ('x') for option '--Nx' is invalid",
+			"3\t3\terror\tColumns differ from the columns of the first parameter set",
+			"4\t4\tok\t"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(status.begin(), status.end(), expected_status.begin(), expected_status.end());
+
+	std::remove("./test_sweep.dat");
+	std::remove("./test_sweep_status.dat");
+}
@@ -70,3 +70,17 @@ BOOST_AUTO_TEST_CASE(test_simps_even) {
 	// scipy.integrate.simps(even='right')
 	BOOST_CHECK_CLOSE_FRACTION(result, 1.9999976227091623, 1e-12);
 }
+
+BOOST_AUTO_TEST_CASE(test_callable_vs_array) {
+	const size_t N = 12;
+	const auto x = get_x(N);
+	const auto y = get_y(x);
+	const auto f = [&y](const size_t i) { return y[i]; };
+
+	BOOST_CHECK_EQUAL(trapz(x, f, 0, N-1), trapz(x, y, 0, N-1));
+	BOOST_CHECK_EQUAL(simps(x, f, 0, N-1), simps(x, y, 0, N-1));
+	BOOST_CHECK_EQUAL(disk_radial_trapz(x, f, 0, N-1), disk_radial_trapz(x, y, 0, N-1));
+	// std::function is still accepted
+	const std::function<double (size_t)> std_f = f;
+	BOOST_CHECK_EQUAL(trapz(x, std_f, 0, N-1), trapz(x, y, 0, N-1));
+}
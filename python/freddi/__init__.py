@@ -18,7 +18,8 @@ class _MetaFreddi(type(_Freddi)):
                 continue
             attrs[attr_name] = property(partial(mcs._boost_cls_property, attr_name))
             obj_attr = getattr(test_obj, attr_name)
-            if isinstance(obj_attr, np.ndarray):
+            # Radial distributions only, not per-band values like Lx_bands
+            if isinstance(obj_attr, np.ndarray) and obj_attr.shape == (test_obj.Nx,):
                 attrs['first_' + attr_name] = property(partial(mcs._first_last_getter, 'first', attr_name))
                 attrs['last_' + attr_name] = property(partial(mcs._first_last_getter, 'last', attr_name))
 
@@ -81,6 +82,11 @@ class _BasePyFreddi:
         def _(value):
             return {k: convert(v) for k, v in value.items()}
 
+        @convert.register(list)
+        @convert.register(tuple)
+        def _(value):
+            return type(value)(convert(v) for v in value)
+
         kwargs = {key: convert(value) for key, value in kwargs.items()}
         
         return cls(**kwargs)
@@ -90,51 +96,80 @@ class _BasePyFreddi:
         """Alias to .from_astropy()"""
         return cls.from_astropy(**kwargs)
 
-    def evolve(self):
+    def evolve(self, times=None):
         """Calculate disk evolution
 
+        Parameters
+        ----------
+        times : array_like or None, optional
+            Time moments to calculate disk states at, in seconds. The time
+            step before every moment is shortened to land on it, and moments
+            after the end of the calculation are dropped. If None, states are
+            calculated for every time step
+
         Returns
         -------
         EvolutionResults
 
-        """
-        return EvolutionResult(self)
+        Raises
+        ------
+        ValueError
+            If any of `times` is earlier than `inittime`
 
-    def _flux_hot(self, lmbd, phase):
+        """
+        if times is None:
+            return EvolutionResult(self)
+        times = np.sort(np.asarray(times, dtype=float).ravel())
+        if times.size > 0 and times[0] < self._kwargs['inittime']:
+            raise ValueError('times should not be earlier than inittime')
+        states = []
+        for t in times:
+            state = self._freddi._evolve_to(t)
+            if state is None:
+                break
+            states.append(self._from_boost(state))
+        return EvolutionResult(states)
+
+    def _flux_hot(self, lmbd, phase, observer):
         del phase
-        return self._freddi._flux_hot(lmbd)
+        if observer is None:
+            return self._freddi._spectrum_hot(lmbd)
+        return self._freddi._spectrum_hot_observer(lmbd, observer)
 
-    def _flux_cold(self, lmbd, phase):
+    def _flux_cold(self, lmbd, phase, observer):
         del phase
-        return self._freddi._flux_cold(lmbd)
+        if observer is None:
+            return self._freddi._spectrum_cold(lmbd)
+        return self._freddi._spectrum_cold_observer(lmbd, observer)
 
-    def _flux_star(self, lmbd, phase):
+    def _flux_star(self, lmbd, phase, observer):
         if phase is None:
             raise ValueError('Phase must be specified if star flux is required')
-        return self._freddi._flux_star(lmbd, phase)
+        if observer is None:
+            return self._freddi._spectrum_star(lmbd, phase)
+        return self._freddi._spectrum_star_observer(lmbd, phase, observer)
 
-    def flux(self, lmbd, region='hot', phase=None):
+    def flux(self, lmbd, region='hot', phase=None, observer=None):
         region = region.lower()
         if 'hot'.startswith(region):
             flux = self._flux_hot
         elif 'cold'.startswith(region):
             flux = self._flux_cold
         elif 'disk'.startswith(region):
-            def flux(lmbd, phase):
-                return self._flux_hot(lmbd, phase) + self._flux_cold(lmbd, phase)
+            def flux(lmbd, phase, observer):
+                return self._flux_hot(lmbd, phase, observer) + self._flux_cold(lmbd, phase, observer)
         elif 'star'.startswith(region):
             flux = self._flux_star
         elif 'all'.startswith(region):
-            def flux(lmbd, phase):
-                return self._flux_hot(lmbd, phase) + self._flux_cold(lmbd, phase) + self._flux_star(lmbd, phase)
+            def flux(lmbd, phase, observer):
+                return (self._flux_hot(lmbd, phase, observer) + self._flux_cold(lmbd, phase, observer)
+                        + self._flux_star(lmbd, phase, observer))
         else:
             raise ValueError(f'Zone {region} is not supported')
 
-        lmbd = np.asarray(lmbd)
-        arr = np.empty_like(lmbd, dtype=float)
-        for i, x in np.ndenumerate(lmbd):
-            arr[i] = flux(float(x), phase)
-        return arr
+        # Fluxes for all wavelengths are calculated in a single pass over the disk or the star surface
+        lmbd = np.asarray(lmbd, dtype=float)
+        return np.asarray(flux(np.ascontiguousarray(lmbd.ravel()), phase, observer), dtype=float).reshape(lmbd.shape)
 
     def __iter__(self):
         for value in self._freddi:
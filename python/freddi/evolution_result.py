@@ -13,7 +13,7 @@ class EvolutionResult:
 
     Methods
     -------
-    flux(lmbd, region, phase) : array
+    flux(lmbd, region, phase, observer) : array
         Optical flux of the disk
 
     """
@@ -21,7 +21,7 @@ class EvolutionResult:
         self.__states = tuple(states)
         self.__len_states = len(self.__states)
 
-    def flux(self, lmbd, region='hot', phase=None) -> np.ndarray:
+    def flux(self, lmbd, region='hot', phase=None, observer=None) -> np.ndarray:
         """Optical flux of the disk
 
         Parameters
@@ -34,6 +34,10 @@ class EvolutionResult:
         phase: array-like or float or None, optional
             Phase of the observation in radians, must be specified if `region`
             is `star` or `all`
+        observer: int or None, optional
+            Index of the additional observer given by `observers` argument of
+            `Freddi`. If None, the flux is calculated for the main observer
+            defined by `inclination` and `distance`
 
         Returns
         -------
@@ -49,7 +53,7 @@ class EvolutionResult:
         lmbd = np.asarray(lmbd)
         arr = np.empty((self.__len_states,) + lmbd.shape, dtype=float)
         for i in range(self.__len_states):
-            arr[i] = self.__states[i].flux(lmbd, region, phase[i])
+            arr[i] = self.__states[i].flux(lmbd, region, phase[i], observer)
         return arr
 
     def __getattr__(self, attr) -> np.ndarray:
@@ -60,6 +64,9 @@ class EvolutionResult:
             for i in range(1, self.__len_states):
                 arr[i] = getattr(self.__states[i], attr)
             return arr
+        elif first_val.ndim == 1 and first_val.shape != (self.__states[0].Nx,):
+            # Per-band values like Lx_bands
+            return np.stack([np.asarray(getattr(state, attr)) for state in self.__states])
         elif first_val.ndim == 1:
             arr = np.full((self.__len_states, self.__states[0].Nx), np.nan, dtype=first_val.dtype)
             for i, state in enumerate(self.__states):
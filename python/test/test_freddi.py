@@ -2,7 +2,17 @@ import unittest
 
 import numpy as np
 
-from freddi import Freddi
+from freddi import Freddi, FreddiNeutronStar
+
+
+# Binary system and disk shared by the tests, a test case overrides the parameters it varies
+KWARGS = dict(Mx=1e34, Mopt=1e33, period=2e4,
+              F0=2e38, initialcond='powerF', powerorder=6,
+              alpha=0.25, distance=1e19, time=100 * 86400,
+              tau=0.25 * 86400, Nx=200)
+
+# Outburst with a cooling front
+HOT_KWARGS = dict(KWARGS, Thot=1e4, initialcond='sineF', time=50 * 86400)
 
 
 class ChangeArgsTestCase(unittest.TestCase):
@@ -22,10 +32,7 @@ class ChangeArgsTestCase(unittest.TestCase):
 class TwoDimensionalValueTestCase(unittest.TestCase):
     def test(self):
         Nx = 1000
-        fr = Freddi(Mx=1e34, Mopt=1e33, period=2e4,
-                    F0=2e38, Thot=1e4, initialcond='sineF',
-                    alpha=0.25, distance=1e19,
-                    Nx=Nx, time=50 * 86400)
+        fr = Freddi(**dict(HOT_KWARGS, Nx=Nx))
         evolution_result = fr.evolve()
 
         np.testing.assert_equal(evolution_result.Nx, Nx)
@@ -42,3 +49,151 @@ class TwoDimensionalValueTestCase(unittest.TestCase):
                 val = getattr(evolution_result, attr)
                 self.assertTrue(np.all(np.isnan(val[nan_idx])))
                 self.assertFalse(np.any(np.isnan(val[~nan_idx])))
+
+
+class FrontTrackingTestCase(unittest.TestCase):
+    kwargs = HOT_KWARGS
+
+    def test_R_hot(self):
+        result = Freddi(**dict(self.kwargs, Nx=300, fronttracking=True)).evolve()
+        reference = Freddi(**dict(self.kwargs, Nx=3000, fronttracking=True)).evolve()
+        # the hot disk shrinks smoothly, not by whole grid cells
+        self.assertTrue(np.all(np.diff(result.R_hot) <= 0))
+        self.assertGreater(np.unique(result.R_hot).size, np.unique(result.last).size)
+        np.testing.assert_allclose(result.R_hot, reference.R_hot, rtol=0.1)
+
+
+class GridRefinementTestCase(unittest.TestCase):
+    kwargs = HOT_KWARGS
+
+    def test_Mdot(self):
+        result = Freddi(**dict(self.kwargs, Nx=300, regridtol=0.02)).evolve()
+        reference = Freddi(**dict(self.kwargs, Nx=3000)).evolve()
+        # the grid is redistributed but its size is kept
+        self.assertEqual(result.h.shape[1], 300)
+        self.assertTrue(np.all(np.diff(result.h[-1, result.first[-1]:result.last[-1] + 1]) > 0))
+        np.testing.assert_allclose(result.Mdot, reference.Mdot, rtol=0.1)
+        np.testing.assert_allclose(result.Mdisk, reference.Mdisk, rtol=0.1)
+
+
+class TimeSchemeTestCase(unittest.TestCase):
+    kwargs = dict(KWARGS, time=50 * 86400, Nx=1000)
+
+    def test_trbdf2(self):
+        reference = Freddi(**dict(self.kwargs, tau=0.05 * 86400, timescheme='trbdf2')).evolve()
+        euler = Freddi(**dict(self.kwargs, tau=86400)).evolve()
+        trbdf2 = Freddi(**dict(self.kwargs, tau=86400, timescheme='trbdf2')).evolve()
+        idx = euler.t >= 10 * 86400
+        reference_Mdot = np.interp(euler.t[idx], reference.t, reference.Mdot)
+        np.testing.assert_allclose(trbdf2.Mdot[idx], reference_Mdot, rtol=0.01)
+        euler_error = np.max(np.abs(euler.Mdot[idx] / reference_Mdot - 1))
+        trbdf2_error = np.max(np.abs(trbdf2.Mdot[idx] / reference_Mdot - 1))
+        self.assertLess(trbdf2_error, 0.1 * euler_error)
+
+
+class SpaceSchemeTestCase(unittest.TestCase):
+    kwargs = dict(KWARGS, time=50 * 86400, tau=0.1 * 86400, timescheme='trbdf2')
+
+    def test_compact(self):
+        reference = Freddi(**dict(self.kwargs, Nx=2000)).evolve()
+        central = Freddi(**dict(self.kwargs, Nx=100)).evolve()
+        compact = Freddi(**dict(self.kwargs, Nx=100, spacescheme='compact')).evolve()
+        idx = reference.t >= 10 * 86400
+        central_error = np.max(np.abs(central.Mdot[idx] / reference.Mdot[idx] - 1))
+        compact_error = np.max(np.abs(compact.Mdot[idx] / reference.Mdot[idx] - 1))
+        self.assertLess(compact_error, 0.1 * central_error)
+
+
+class QuiescenceTestCase(unittest.TestCase):
+    kwargs = KWARGS
+
+    def test_quiescent_step(self):
+        full = Freddi(**self.kwargs).evolve()
+        middle = len(full.t) // 2
+        fast = Freddi(Mdotquiescent=full.Mdot[middle], tauquiescent=86400, **self.kwargs).evolve()
+        self.assertLess(len(fast.t), len(full.t))
+        self.assertAlmostEqual(fast.t[-1], full.t[-1])
+        np.testing.assert_array_equal(fast.Mdot[:middle + 1], full.Mdot[:middle + 1])
+        np.testing.assert_allclose(fast.Mdot, np.interp(fast.t, full.t, full.Mdot), rtol=0.02)
+
+
+class SelfSimilarTestCase(unittest.TestCase):
+    kwargs = dict(KWARGS, time=200 * 86400)
+
+    def test_self_similar(self):
+        numerical = Freddi(**self.kwargs).evolve()
+        analytical = Freddi(selfsimilartol=1e-3, **self.kwargs).evolve()
+        np.testing.assert_allclose(analytical.Mdot, numerical.Mdot, rtol=0.01)
+        # Mdot^(-m) is linear in time for the self-similar decay, m = 0.3 for Kramers opacity
+        x = analytical.Mdot[analytical.t >= 100 * 86400] ** -0.3
+        np.testing.assert_allclose(np.diff(x, 2), 0, atol=1e-10 * x[-1])
+
+
+class StopConditionTestCase(unittest.TestCase):
+    kwargs = KWARGS
+
+    def test_stop_Mdot(self):
+        full = Freddi(**self.kwargs).evolve()
+        middle = len(full.t) // 2
+        result = Freddi(stopMdot=full.Mdot[middle], **self.kwargs).evolve()
+        self.assertEqual(len(result.t), middle + 2)
+        np.testing.assert_array_equal(result.Mdot, full.Mdot[:middle + 2])
+
+    def test_stop_outbursts(self):
+        result = Freddi(stopoutbursts=1, **self.kwargs).evolve()
+        self.assertEqual(np.argmax(result.Mdot), len(result.t) - 2)
+
+
+class OutputTimesTestCase(unittest.TestCase):
+    kwargs = KWARGS
+
+    def test_times(self):
+        times = np.array([50.123, 3.3, 10.7, 25.0, 99.99, 150.0]) * 86400
+        result = Freddi(**self.kwargs).evolve(times=times)
+        # the moment after the end of the calculation is dropped
+        np.testing.assert_allclose(result.t, np.sort(times)[:-1], rtol=1e-12)
+        full = Freddi(**self.kwargs).evolve()
+        np.testing.assert_allclose(result.Mdot, np.interp(result.t, full.t, full.Mdot), rtol=0.01)
+
+    def test_times_before_inittime(self):
+        freddi = Freddi(inittime=10 * 86400, **self.kwargs)
+        with self.assertRaises(ValueError):
+            freddi.evolve(times=[5 * 86400, 20 * 86400])
+        result = freddi.evolve(times=[10 * 86400, 20 * 86400])
+        np.testing.assert_allclose(result.t, [10 * 86400, 20 * 86400], rtol=1e-12)
+
+
+class ObserversTestCase(unittest.TestCase):
+    kwargs = dict(KWARGS, inclination=30)
+
+    def test_observers(self):
+        lmbd = np.array([3e-5, 5.5e-5])
+        observers = [(30, 1e19), (75, 3e19)]
+        result = Freddi(observers=observers, Topt=1e4, **self.kwargs).evolve()
+        main = result.flux(lmbd, region='all', phase=0.3)
+        np.testing.assert_allclose(result.flux(lmbd, region='all', phase=0.3, observer=0), main, rtol=1e-12)
+        hot = result.flux(lmbd, region='hot', observer=1)
+        np.testing.assert_allclose(hot, result.flux(lmbd) * np.cos(np.radians(75)) / np.cos(np.radians(30)) / 9,
+                                   rtol=1e-12)
+        with self.assertRaises(IndexError):
+            result.flux(lmbd, observer=2)
+
+
+class XBandsTestCase(unittest.TestCase):
+    kwargs = KWARGS
+
+    def test_xbands(self):
+        keV = 2.417989242e17
+        # the first band is the default [emin, emax]
+        xbands = [(1 * keV, 12 * keV), (0.5 * keV, 2 * keV), (2 * keV, 10 * keV), (0.5 * keV, 10 * keV)]
+        for cls in (Freddi, FreddiNeutronStar):
+            kwargs = dict(self.kwargs)
+            if cls is FreddiNeutronStar:
+                kwargs.update(Mx=2.8e33, Bx=1e8)
+            result = cls(xbands=xbands, **kwargs).evolve()
+            self.assertEqual(result.Lx_bands.shape, (len(result.t), len(xbands)))
+            np.testing.assert_allclose(result.Lx_bands[:, 0], result.Lx, rtol=1e-3)
+            np.testing.assert_allclose(result.Lx_bands[:, 1] + result.Lx_bands[:, 2], result.Lx_bands[:, 3],
+                                       rtol=1e-10)
+            if cls is FreddiNeutronStar:
+                np.testing.assert_allclose(result.Lx_ns_bands[:, 0], result.Lx_ns, rtol=1e-3)